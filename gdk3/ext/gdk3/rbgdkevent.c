@@ -297,60 +297,6 @@ rb_gdk_event_type_to_class(GdkEventType event_type)
     return klass;
 }
 
-static GType
-rb_gdk_event_to_gtype(VALUE event)
-{
-    VALUE klass;
-    GType type = GDK_TYPE_EVENT;
-
-    klass = rb_obj_class(event);
-    if (klass == rb_cGdkEvent) {
-        type = GDK_TYPE_EVENT;
-    } else if (klass == rb_cGdkEventAny) {
-        type = GDK_TYPE_EVENT_ANY;
-    } else if (klass == rb_cGdkEventExpose) {
-        type = GDK_TYPE_EVENT_EXPOSE;
-    } else if (klass == rb_cGdkEventVisibility) {
-        type = GDK_TYPE_EVENT_VISIBILITY;
-    } else if (klass == rb_cGdkEventMotion) {
-        type = GDK_TYPE_EVENT_MOTION;
-    } else if (klass == rb_cGdkEventButton) {
-        type = GDK_TYPE_EVENT_BUTTON;
-    } else if (klass == rb_cGdkEventScroll) {
-        type = GDK_TYPE_EVENT_SCROLL;
-    } else if (klass == rb_cGdkEventKey) {
-        type = GDK_TYPE_EVENT_KEY;
-    } else if (klass == rb_cGdkEventCrossing) {
-        type = GDK_TYPE_EVENT_CROSSING;
-    } else if (klass == rb_cGdkEventFocus) {
-        type = GDK_TYPE_EVENT_FOCUS;
-    } else if (klass == rb_cGdkEventConfigure) {
-        type = GDK_TYPE_EVENT_CONFIGURE;
-    } else if (klass == rb_cGdkEventProperty) {
-        type = GDK_TYPE_EVENT_PROPERTY;
-    } else if (klass == rb_cGdkEventSelection) {
-        type = GDK_TYPE_EVENT_SELECTION;
-    } else if (klass == rb_cGdkEventOwnerChange) {
-        type = GDK_TYPE_EVENT_OWNER_CHANGE;
-    } else if (klass == rb_cGdkEventProximity) {
-        type = GDK_TYPE_EVENT_PROXIMITY;
-    } else if (klass == rb_cGdkEventDND) {
-        type = GDK_TYPE_EVENT_DND;
-    } else if (klass == rb_cGdkEventWindowState) {
-        type = GDK_TYPE_EVENT_WINDOW_STATE;
-    } else if (klass == rb_cGdkEventSetting) {
-        type = GDK_TYPE_EVENT_SETTING;
-    } else if (klass == rb_cGdkEventGrabBroken) {
-        type = GDK_TYPE_EVENT_GRAB_BROKEN;
-    } else if (klass == rb_cGdkEventTouch) {
-        type = GDK_TYPE_EVENT_TOUCH;
-    } else {
-        rb_raise(rb_eArgError, "Not event object: %s", RBG_INSPECT(event));
-    }
-
-    return type;
-}
-
 VALUE
 rbgdk_gdkevent2rval(GdkEvent *event)
 {
@@ -360,7 +306,56 @@ rbgdk_gdkevent2rval(GdkEvent *event)
 GdkEvent *
 rbgdk_rval2gdkevent(VALUE event)
 {
-    return RVAL2BOXED(event, rb_gdk_event_to_gtype(event));
+    if (!RVAL2CBOOL(rb_obj_is_kind_of(event, rb_cGdkEvent)))
+        rb_raise(rb_eArgError, "Not event object: %s", RBG_INSPECT(event));
+
+    return rbgobj_boxed_peek(event);
+}
+
+/* Methods are only defined on the event classes, so self is always a
+ * Gdk::Event and its GdkEvent is read without any type lookup. */
+#define GDKEVENT_SELF(self) ((GdkEvent *)rbgobj_boxed_peek(self))
+
+/*
+ * Readers of each event class in definition order, for #to_h. Classes
+ * live as long as the process, so they are used as keys as is.
+ */
+typedef VALUE (*EventFieldReader)(VALUE self);
+
+typedef struct {
+    ID id;
+    EventFieldReader reader;
+} EventField;
+
+static GHashTable *event_fields;
+
+static void
+rb_gdk_event_define_field(VALUE klass, const gchar *name,
+                          EventFieldReader reader)
+{
+    GArray *fields;
+    EventField field;
+
+    fields = g_hash_table_lookup(event_fields, (gpointer)klass);
+    if (!fields) {
+        fields = g_array_new(FALSE, FALSE, sizeof(EventField));
+        g_hash_table_insert(event_fields, (gpointer)klass, fields);
+    }
+    field.id = rb_intern(name);
+    field.reader = reader;
+    g_array_append_val(fields, field);
+}
+
+static GArray *
+rb_gdk_event_class_fields(VALUE klass)
+{
+    GArray *fields = NULL;
+
+    while (!fields && klass != rb_cGdkEvent && RTEST(klass)) {
+        fields = g_hash_table_lookup(event_fields, (gpointer)klass);
+        klass = rb_class_superclass(klass);
+    }
+    return fields;
 }
 
 /***********************************************/
@@ -368,12 +363,12 @@ rbgdk_rval2gdkevent(VALUE event)
 static VALUE \
 gdkevent ## type ## _ ## name (VALUE self)\
 {\
-    return CSTR2RVAL(RVAL2GDKEVENT(self)->type.name);\
+    return CSTR2RVAL(GDKEVENT_SELF(self)->type.name);\
 }\
 static VALUE \
 gdkevent ## type ## _set_ ## name (VALUE self, VALUE val)\
 {\
-    RVAL2GDKEVENT(self)->type.name = (gchar *)RVAL2CSTR(val);\
+    GDKEVENT_SELF(self)->type.name = (gchar *)RVAL2CSTR(val);\
     return self;\
 }
 
@@ -381,12 +376,12 @@ gdkevent ## type ## _set_ ## name (VALUE self, VALUE val)\
 static VALUE \
 gdkevent ## type ## _ ## name (VALUE self)\
 {\
-    return INT2NUM(RVAL2GDKEVENT(self)->type.name);\
+    return INT2NUM(GDKEVENT_SELF(self)->type.name);\
 }\
 static VALUE \
 gdkevent ## type ## _set_ ## name (VALUE self, VALUE val)\
 {\
-    RVAL2GDKEVENT(self)->type.name = NUM2INT(val);\
+    GDKEVENT_SELF(self)->type.name = NUM2INT(val);\
     return self;\
 }
 
@@ -394,12 +389,12 @@ gdkevent ## type ## _set_ ## name (VALUE self, VALUE val)\
 static VALUE \
 gdkevent ## type ## _ ## name (VALUE self)\
 {\
-    return UINT2NUM(RVAL2GDKEVENT(self)->type.name);\
+    return UINT2NUM(GDKEVENT_SELF(self)->type.name);\
 }\
 static VALUE \
 gdkevent ## type ## _set_ ## name (VALUE self, VALUE val)\
 {\
-    RVAL2GDKEVENT(self)->type.name = NUM2UINT(val);\
+    GDKEVENT_SELF(self)->type.name = NUM2UINT(val);\
     return self;\
 }
 
@@ -407,12 +402,12 @@ gdkevent ## type ## _set_ ## name (VALUE self, VALUE val)\
 static VALUE \
 gdkevent ## type ## _ ## name (VALUE self)\
 {\
-    return GOBJ2RVAL(RVAL2GDKEVENT(self)->type.name);\
+    return GOBJ2RVAL(GDKEVENT_SELF(self)->type.name);\
 }\
 static VALUE \
 gdkevent ## type ## _set_ ## name (VALUE self, VALUE val)\
 {\
-    RVAL2GDKEVENT(self)->type.name = RVAL2GDKWINDOW(val);\
+    GDKEVENT_SELF(self)->type.name = RVAL2GDKWINDOW(val);\
     return self;\
 }
 
@@ -420,12 +415,12 @@ gdkevent ## type ## _set_ ## name (VALUE self, VALUE val)\
 static VALUE \
 gdkevent ## type ## _ ## name (VALUE self)\
 {\
-    return rb_float_new(RVAL2GDKEVENT(self)->type.name);\
+    return rb_float_new(GDKEVENT_SELF(self)->type.name);\
 }\
 static VALUE \
 gdkevent ## type ## _set_ ## name (VALUE self, VALUE val)\
 {\
-    RVAL2GDKEVENT(self)->type.name = NUM2DBL(val);\
+    GDKEVENT_SELF(self)->type.name = NUM2DBL(val);\
     return self;\
 }
 
@@ -433,13 +428,13 @@ gdkevent ## type ## _set_ ## name (VALUE self, VALUE val)\
 static VALUE \
 gdkevent ## type ## _ ## name (VALUE self)\
 {\
-    return GOBJ2RVAL(RVAL2GDKEVENT(self)->type.name);\
+    return GOBJ2RVAL(GDKEVENT_SELF(self)->type.name);\
 }\
 static VALUE \
 gdkevent ## type ## _set_ ## name (VALUE self, VALUE val)\
 {\
     GdkEvent *event;\
-    event = RVAL2GDKEVENT(self);\
+    event = GDKEVENT_SELF(self);\
     if (event->type.name)\
       g_object_unref(event->type.name);\
     event->type.name = RVAL2GOBJ(val);\
@@ -452,12 +447,12 @@ gdkevent ## type ## _set_ ## name (VALUE self, VALUE val)\
 static VALUE \
 gdkevent ## type ## _ ## name (VALUE self)\
 {\
-    return CBOOL2RVAL(RVAL2GDKEVENT(self)->type.name);\
+    return CBOOL2RVAL(GDKEVENT_SELF(self)->type.name);\
 }\
 static VALUE \
 gdkevent ## type ## _set_ ## name (VALUE self, VALUE val)\
 {\
-    RVAL2GDKEVENT(self)->type.name = RVAL2CBOOL(val);\
+    GDKEVENT_SELF(self)->type.name = RVAL2CBOOL(val);\
     return self;\
 }
 
@@ -465,13 +460,13 @@ gdkevent ## type ## _set_ ## name (VALUE self, VALUE val)\
 static VALUE \
 gdkevent ## type ## _ ## name (VALUE self)\
 {\
-    GdkAtom atom = RVAL2GDKEVENT(self)->type.name;\
+    GdkAtom atom = GDKEVENT_SELF(self)->type.name;\
     return GDKATOM2RVAL(atom);\
 }\
 static VALUE \
 gdkevent ## type ## _set_ ## name (VALUE self, VALUE val)\
 {\
-    RVAL2GDKEVENT(self)->type.name = RVAL2ATOM(val);\
+    GDKEVENT_SELF(self)->type.name = RVAL2ATOM(val);\
     return self;\
 }
 
@@ -479,12 +474,12 @@ gdkevent ## type ## _set_ ## name (VALUE self, VALUE val)\
 static VALUE \
 gdkevent ## type ## _ ## name (VALUE self)\
 {\
-    return GFLAGS2RVAL(RVAL2GDKEVENT(self)->type.name, gtype);\
+    return GFLAGS2RVAL(GDKEVENT_SELF(self)->type.name, gtype);\
 }\
 static VALUE \
 gdkevent ## type ## _set_ ## name (VALUE self, VALUE val)\
 {\
-    RVAL2GDKEVENT(self)->type.name = RVAL2GFLAGS(val, gtype);\
+    GDKEVENT_SELF(self)->type.name = RVAL2GFLAGS(val, gtype);\
     return self;\
 }
 
@@ -492,12 +487,12 @@ gdkevent ## type ## _set_ ## name (VALUE self, VALUE val)\
 static VALUE \
 gdkevent ## type ## _ ## name (VALUE self)\
 {\
-    return GENUM2RVAL(RVAL2GDKEVENT(self)->type.name, gtype);\
+    return GENUM2RVAL(GDKEVENT_SELF(self)->type.name, gtype);\
 }\
 static VALUE \
 gdkevent ## type ## _set_ ## name (VALUE self, VALUE val)\
 {\
-    RVAL2GDKEVENT(self)->type.name = RVAL2GENUM(val, gtype);\
+    GDKEVENT_SELF(self)->type.name = RVAL2GENUM(val, gtype);\
     return self;\
 }
 
@@ -505,7 +500,7 @@ gdkevent ## type ## _set_ ## name (VALUE self, VALUE val)\
 static VALUE \
 gdkevent ##type ## _axes(VALUE self)\
 {\
-    gdkklass type = RVAL2GDKEVENT(self)->type;\
+    gdkklass type = GDKEVENT_SELF(self)->type;\
     return type.axes ? rb_ary_new3(2, \
                        rb_float_new(type.axes[0]),\
                        rb_float_new(type.axes[1])) : Qnil;\
@@ -513,15 +508,19 @@ gdkevent ##type ## _axes(VALUE self)\
 static VALUE \
 gdkevent ## type ## _set_axes(VALUE self, VALUE x, VALUE y)\
 {\
-    gdkklass val = RVAL2GDKEVENT(self)->type;\
+    gdkklass val = GDKEVENT_SELF(self)->type;\
     val.axes[0] = NUM2DBL(x);\
     val.axes[1] = NUM2DBL(y);\
     return self;\
 }
 
+#define DEFINE_FIELD(event, name, reader) \
+    rb_gdk_event_define_field(event, name, reader)
+
 #define DEFINE_ACCESSOR(event, type, name) \
     rbg_define_method(event, G_STRINGIFY(name), gdkevent ## type ## _## name, 0);\
-    rbg_define_method(event, G_STRINGIFY(set_ ## name), gdkevent ## type ## _set_## name, 1);
+    rbg_define_method(event, G_STRINGIFY(set_ ## name), gdkevent ## type ## _set_## name, 1);\
+    DEFINE_FIELD(event, G_STRINGIFY(name), gdkevent ## type ## _## name);
 
 
 /* initialize */
@@ -587,13 +586,57 @@ gdkevent_initialize(VALUE self, VALUE type)
 static VALUE
 gdkevent_type(VALUE self)
 {
-    return GDKEVENTTYPE2RVAL(RVAL2GDKEVENT(self)->type);
+    return GDKEVENTTYPE2RVAL(GDKEVENT_SELF(self)->type);
+}
+
+/*
+ * Returns all fields of the event as a Hash with Symbol keys in one
+ * call, e.g. {:event_type => ..., :time => ..., :x => ..., ...}.
+ */
+static VALUE
+gdkevent_to_h(VALUE self)
+{
+    GArray *fields;
+    VALUE hash;
+    guint i;
+
+    hash = rb_hash_new();
+    rb_hash_aset(hash, ID2SYM(rb_intern("event_type")), gdkevent_type(self));
+    fields = rb_gdk_event_class_fields(rb_obj_class(self));
+    if (!fields)
+        return hash;
+
+    for (i = 0; i < fields->len; i++) {
+        EventField *field = &g_array_index(fields, EventField, i);
+        rb_hash_aset(hash, ID2SYM(field->id), field->reader(self));
+    }
+    return hash;
+}
+
+static VALUE
+gdkevent_s_fields(VALUE klass)
+{
+    GArray *fields;
+    VALUE names;
+    guint i;
+
+    names = rb_ary_new();
+    rb_ary_push(names, ID2SYM(rb_intern("event_type")));
+    fields = rb_gdk_event_class_fields(klass);
+    if (!fields)
+        return names;
+
+    for (i = 0; i < fields->len; i++) {
+        EventField *field = &g_array_index(fields, EventField, i);
+        rb_ary_push(names, ID2SYM(field->id));
+    }
+    return names;
 }
 
 static VALUE
 gdkevent_put(VALUE self)
 {
-    gdk_event_put(RVAL2GDKEVENT(self));
+    gdk_event_put(GDKEVENT_SELF(self));
     return self;
 }
 
@@ -607,7 +650,7 @@ static VALUE
 gdkevent_get_axis(VALUE self, VALUE axis_use)
 {
     gdouble value;
-    gboolean ret = gdk_event_get_axis(RVAL2GDKEVENT(self), 
+    gboolean ret = gdk_event_get_axis(GDKEVENT_SELF(self), 
                                       RVAL2GDKAXISUSE(axis_use), &value);
     return ret ? rb_float_new(value) : Qnil;
 }
@@ -616,7 +659,7 @@ static VALUE
 gdkevent_get_coords(VALUE self)
 {
     gdouble x_win, y_win;
-    gboolean ret = gdk_event_get_coords(RVAL2GDKEVENT(self), &x_win, &y_win);
+    gboolean ret = gdk_event_get_coords(GDKEVENT_SELF(self), &x_win, &y_win);
 
     return ret ? rb_ary_new3(2, rb_float_new(x_win), rb_float_new(y_win)) : Qnil;
 }
@@ -625,7 +668,7 @@ static VALUE
 gdkevent_get_root_coords(VALUE self)
 {
     gdouble x_root, y_root;
-    gboolean ret = gdk_event_get_root_coords(RVAL2GDKEVENT(self), &x_root, &y_root);
+    gboolean ret = gdk_event_get_root_coords(GDKEVENT_SELF(self), &x_root, &y_root);
 
     return ret ? rb_ary_new3(2, rb_float_new(x_root), rb_float_new(y_root)) : Qnil;
 }
@@ -662,14 +705,14 @@ gdkevent_s_set_show_events(VALUE self, VALUE show_events)
 static VALUE
 gdkevent_set_screen(VALUE self, VALUE screen)
 {
-    gdk_event_set_screen(RVAL2GDKEVENT(self), RVAL2GDKSCREEN(screen));
+    gdk_event_set_screen(GDKEVENT_SELF(self), RVAL2GDKSCREEN(screen));
     return self;
 }
 
 static VALUE
 gdkevent_screen(VALUE self)
 {
-    return GOBJ2RVAL(gdk_event_get_screen(RVAL2GDKEVENT(self)));
+    return GOBJ2RVAL(gdk_event_get_screen(GDKEVENT_SELF(self)));
 }
 
 /*
@@ -759,7 +802,7 @@ GDKEVENT_INIT(motion, GDK_MOTION_NOTIFY);
 static VALUE
 gdkeventmotion_request_motions(VALUE self)
 {
-    gdk_event_request_motions(&(RVAL2GDKEVENT(self)->motion));
+    gdk_event_request_motions(&(GDKEVENT_SELF(self)->motion));
     return self;
 }
 
@@ -767,14 +810,14 @@ gdkeventmotion_request_motions(VALUE self)
 static VALUE
 gdkeventexpose_area(VALUE self)
 {
-    return GDKRECTANGLE2RVAL(&RVAL2GDKEVENT(self)->expose.area);
+    return GDKRECTANGLE2RVAL(&GDKEVENT_SELF(self)->expose.area);
 }
 
 static VALUE
 gdkeventexpose_set_area(VALUE self, VALUE rect)
 {
     GdkRectangle* grect = RVAL2GDKRECTANGLE(rect);
-    GdkEventExpose *event = &(RVAL2GDKEVENT(self)->expose);
+    GdkEventExpose *event = &(GDKEVENT_SELF(self)->expose);
     event->area.x = grect->x;
     event->area.y = grect->y;
     event->area.width = grect->width;
@@ -785,13 +828,13 @@ gdkeventexpose_set_area(VALUE self, VALUE rect)
 static VALUE
 gdkeventexpose_region(VALUE self)
 {
-    return CRREGION2RVAL(RVAL2GDKEVENT(self)->expose.region);
+    return CRREGION2RVAL(GDKEVENT_SELF(self)->expose.region);
 }
 
 static VALUE
 gdkeventexpose_set_region(VALUE self, VALUE region)
 {
-    RVAL2GDKEVENT(self)->expose.region = RVAL2CRREGION(region);
+    GDKEVENT_SELF(self)->expose.region = RVAL2CRREGION(region);
     return self;
 }
 
@@ -882,10 +925,14 @@ gdkevent_g2r(const GValue *values)
 void
 Init_gdk_event(VALUE mGdk)
 {
+    event_fields = g_hash_table_new(g_direct_hash, g_direct_equal);
+
     /* GdkEvent */
     rb_cGdkEvent = G_DEF_CLASS(GDK_TYPE_EVENT, "Event", mGdk);
     rbg_define_method(rb_cGdkEvent, "initialize", gdkevent_initialize, 1);
     rbg_define_method(rb_cGdkEvent, "event_type", gdkevent_type, 0);
+    rbg_define_method(rb_cGdkEvent, "to_h", gdkevent_to_h, 0);
+    rbg_define_singleton_method(rb_cGdkEvent, "fields", gdkevent_s_fields, 0);
 
     rbg_define_singleton_method(rb_cGdkEvent, "events_pending?", gdkevent_s_events_pending, 0);
     rbg_define_singleton_method(rb_cGdkEvent, "peek", gdkevent_s_peek, 0);
@@ -929,6 +976,7 @@ Init_gdk_event(VALUE mGdk)
     DEFINE_ACCESSOR(rb_cGdkEventAny, any, window);
     rbg_define_method(rb_cGdkEventAny, "send_event?", gdkeventany_send_event, 0);
     rbg_define_method(rb_cGdkEventAny, "set_send_event", gdkeventany_set_send_event, 1);
+    DEFINE_FIELD(rb_cGdkEventAny, "send_event", gdkeventany_send_event);
 
     /* GdkEventExpose */
     rb_cGdkEventExpose =
@@ -960,9 +1008,11 @@ Init_gdk_event(VALUE mGdk)
     DEFINE_ACCESSOR(rb_cGdkEventMotion, motion, y);
     rbg_define_method(rb_cGdkEventMotion, "axes", gdkeventmotion_axes, 0);
     rbg_define_method(rb_cGdkEventMotion, "set_axes", gdkeventmotion_set_axes, 1);
+    DEFINE_FIELD(rb_cGdkEventMotion, "axes", gdkeventmotion_axes);
     DEFINE_ACCESSOR(rb_cGdkEventMotion, motion, state);
     rbg_define_method(rb_cGdkEventMotion, "hint?", gdkeventmotion_is_hint, 0);
     rbg_define_method(rb_cGdkEventMotion, "set_hint", gdkeventmotion_set_is_hint, 1);
+    DEFINE_FIELD(rb_cGdkEventMotion, "hint", gdkeventmotion_is_hint);
     DEFINE_ACCESSOR(rb_cGdkEventMotion, motion, device);
     DEFINE_ACCESSOR(rb_cGdkEventMotion, motion, x_root);
     DEFINE_ACCESSOR(rb_cGdkEventMotion, motion, y_root);
@@ -978,6 +1028,7 @@ Init_gdk_event(VALUE mGdk)
     DEFINE_ACCESSOR(rb_cGdkEventButton, button, y);
     rbg_define_method(rb_cGdkEventButton, "axes", gdkeventbutton_axes, 0);
     rbg_define_method(rb_cGdkEventButton, "set_axes", gdkeventbutton_set_axes, 2);
+    DEFINE_FIELD(rb_cGdkEventButton, "axes", gdkeventbutton_axes);
     DEFINE_ACCESSOR(rb_cGdkEventButton, button, state);
     DEFINE_ACCESSOR(rb_cGdkEventButton, button, button);
     DEFINE_ACCESSOR(rb_cGdkEventButton, button, device);
@@ -991,11 +1042,13 @@ Init_gdk_event(VALUE mGdk)
     DEFINE_ACCESSOR(rb_cGdkEventTouch, touch, window);
     rbg_define_method(rb_cGdkEventTouch, "send_event?", gdkeventtouch_send_event, 0);
     rbg_define_method(rb_cGdkEventTouch, "set_send_event", gdkeventtouch_set_send_event, 1);
+    DEFINE_FIELD(rb_cGdkEventTouch, "send_event", gdkeventtouch_send_event);
     DEFINE_ACCESSOR(rb_cGdkEventTouch, touch, time);
     DEFINE_ACCESSOR(rb_cGdkEventTouch, touch, x);
     DEFINE_ACCESSOR(rb_cGdkEventTouch, touch, y);
     rbg_define_method(rb_cGdkEventTouch, "axes", gdkeventtouch_axes, 0);
     rbg_define_method(rb_cGdkEventTouch, "set_axes", gdkeventtouch_set_axes, 2);
+    DEFINE_FIELD(rb_cGdkEventTouch, "axes", gdkeventtouch_axes);
     DEFINE_ACCESSOR(rb_cGdkEventTouch, touch, state);
     DEFINE_ACCESSOR(rb_cGdkEventTouch, touch, emulating_pointer);
     DEFINE_ACCESSOR(rb_cGdkEventTouch, touch, device);
@@ -1045,6 +1098,7 @@ Init_gdk_event(VALUE mGdk)
     DEFINE_ACCESSOR(rb_cGdkEventCrossing, crossing, detail);
     rbg_define_method(rb_cGdkEventCrossing, "focus?", gdkeventcrossing_focus, 0);
     rbg_define_method(rb_cGdkEventCrossing, "set_focus", gdkeventcrossing_set_focus, 1);
+    DEFINE_FIELD(rb_cGdkEventCrossing, "focus", gdkeventcrossing_focus);
     DEFINE_ACCESSOR(rb_cGdkEventCrossing, crossing, state);
 
     /* GdkCrossingMode */
@@ -1062,6 +1116,7 @@ Init_gdk_event(VALUE mGdk)
     rbg_define_method(rb_cGdkEventFocus, "in?", gdkeventfocus_change_in, 0);
     rbg_define_method(rb_cGdkEventFocus, "set_in",
                      gdkeventfocus_change_set_in, 1);
+    DEFINE_FIELD(rb_cGdkEventFocus, "in", gdkeventfocus_change_in);
     DEFINE_INIT(rb_cGdkEventFocus, focus_change);
 
     /* GdkEventConfigure */
@@ -1167,6 +1222,8 @@ Init_gdk_event(VALUE mGdk)
                      "implicit?", gdkeventgrab_broken_implicit, 0);
     rbg_define_method(rb_cGdkEventGrabBroken,
                      "set_implicit", gdkeventgrab_broken_set_implicit, 1);
+    DEFINE_FIELD(rb_cGdkEventGrabBroken, "keyboard", gdkeventgrab_broken_keyboard);
+    DEFINE_FIELD(rb_cGdkEventGrabBroken, "implicit", gdkeventgrab_broken_implicit);
     DEFINE_ACCESSOR(rb_cGdkEventGrabBroken, grab_broken, grab_window);
     DEFINE_INIT(rb_cGdkEventGrabBroken, grab_broken);
 
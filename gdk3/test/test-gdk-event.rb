@@ -271,6 +271,14 @@ class TestGdkEvent < Test::Unit::TestCase
         @motion.request
       end
     end
+
+    def test_to_h
+      @motion.set_x(10.5)
+      @motion.set_y(20.5)
+      hash = @motion.to_h
+      assert_equal([Gdk::EventMotion.fields, "GDK_MOTION_NOTIFY", 10.5, 20.5],
+                   [hash.keys, hash[:event_type].name, hash[:x], hash[:y]])
+    end
   end
 
   class TestVisibility < self
@@ -33,6 +33,8 @@ end
 ruby_header = 'ruby.h'
 have_func 'rb_exec_recursive', ruby_header
 have_func 'rb_errinfo', ruby_header
+have_header 'ruby/thread.h'
+have_func 'rb_thread_call_without_gvl', 'ruby/thread.h'
 
 ["glib2"].each do |package|
   directory = "#{package}#{version_suffix}"
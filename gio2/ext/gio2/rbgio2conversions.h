@@ -56,6 +56,7 @@
 #define RVAL2GIOSTREAM(o)                  (G_IO_STREAM(RVAL2GOBJ(o)))
 #define RVAL2GLOADABLEICON(o)              (G_LOADABLE_ICON(RVAL2GOBJ(o)))
 #define RVAL2GMEMORYINPUTSTREAM(o)         (G_MEMORY_INPUT_STREAM(RVAL2GOBJ(o)))
+#define RVAL2GMEMORYOUTPUTSTREAM(o)        (G_MEMORY_OUTPUT_STREAM(RVAL2GOBJ(o)))
 #define RVAL2GMOUNT(o)                     (G_MOUNT(RVAL2GOBJ(o)))
 #define RVAL2GMOUNTOPERATION(o)            (G_MOUNT_OPERATION(RVAL2GOBJ(o)))
 #define RVAL2GNETWORKADDRESS(o)            (G_NETWORK_ADDRESS(RVAL2GOBJ(o)))
@@ -22,6 +22,9 @@
 #define __RBGIO2PRIVATE_H__
 
 #include <ruby.h>
+#ifdef HAVE_RUBY_THREAD_H
+#  include <ruby/thread.h>
+#endif
 
 #include <rbglib.h>
 #include <rbgobject.h>
@@ -55,6 +58,36 @@ G_GNUC_INTERNAL void rbgio_async_ready_callback(GObject *source,
                                        gpointer data);
 G_GNUC_INTERNAL VALUE rbgio_child_remove_and_return(VALUE parent, VALUE child);
 
+#ifdef HAVE_RB_THREAD_CALL_WITHOUT_GVL
+#  define RBGIO_BLOCKING_FUNC_RETURN_TYPE void *
+#  define RBGIO_BLOCKING_FUNC_RETURN_VALUE NULL
+#else
+#  define rb_thread_call_without_gvl(func, func_data, ubf, ubf_data) \
+        rb_thread_blocking_region(func, func_data, ubf, ubf_data)
+#  define RBGIO_BLOCKING_FUNC_RETURN_TYPE VALUE
+#  define RBGIO_BLOCKING_FUNC_RETURN_VALUE Qnil
+#endif
+
+/* Common head of the data passed to rbgio_blocking_call(). */
+typedef struct {
+        GCancellable *cancellable;
+        GError *error;
+} RBGIOBlockingCall;
+
+typedef RBGIO_BLOCKING_FUNC_RETURN_TYPE (*RBGIOBlockingFunc)(void *call);
+
+G_GNUC_INTERNAL void rbgio_blocking_call(RBGIOBlockingFunc func,
+                                         RBGIOBlockingCall *call,
+                                         VALUE rbcancellable);
+G_GNUC_INTERNAL char *rbgio_read_buffer_prepare(VALUE rbbuffer,
+                                               gsize offset,
+                                               gsize count);
+G_GNUC_INTERNAL void rbgio_read_buffer_call(RBGIOBlockingFunc func,
+                                            RBGIOBlockingCall *call,
+                                            VALUE rbcancellable,
+                                            VALUE rbbuffer,
+                                            gsize offset);
+
 G_GNUC_INTERNAL void Init_gio(void);
 G_GNUC_INTERNAL void Init_gappinfo(VALUE mGio);
 G_GNUC_INTERNAL void Init_gapplaunchcontext(VALUE mGio);
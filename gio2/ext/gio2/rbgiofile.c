@@ -1912,6 +1912,449 @@ rg_supports_thread_contexts_p(VALUE self)
         return CBOOL2RVAL(g_file_supports_thread_contexts(_SELF(self)));
 }
 
+/*
+ * copy_tree copies a directory tree on GIO's worker threads. Every
+ * directory is listed and created in a thread job and every file is
+ * copied with g_file_copy_async(); at most jobs of them run at once.
+ * All bookkeeping happens in the main loop, so it needs no locking.
+ * Ruby is only entered for throttled progress reports and for the
+ * final callback.
+ */
+typedef struct _CopyTree CopyTree;
+
+typedef struct {
+        CopyTree *tree;
+        GFile *source;
+        GFile *destination;
+        gboolean is_directory;
+        goffset size;
+        goffset current_num_bytes;
+        GList *children;
+} CopyTreeTask;
+
+struct _CopyTree {
+        GSimpleAsyncResult *result;
+        GFileCopyFlags flags;
+        guint jobs;
+        int io_priority;
+        GCancellable *cancellable;
+        GCancellable *user_cancellable;
+        gulong cancelled_id;
+        VALUE callbacks;
+        gint64 progress_interval;
+        gint64 last_progress;
+        GQueue *tasks;
+        guint n_running;
+        guint n_files;
+        guint n_files_done;
+        goffset n_bytes;
+        goffset n_bytes_done;
+        GError *error;
+};
+
+#define COPY_TREE_ATTRIBUTES \
+        G_FILE_ATTRIBUTE_STANDARD_NAME "," \
+        G_FILE_ATTRIBUTE_STANDARD_TYPE "," \
+        G_FILE_ATTRIBUTE_STANDARD_SIZE
+
+static void copy_tree_schedule(CopyTree *tree);
+
+static CopyTreeTask *
+copy_tree_task_new(CopyTree *tree, GFile *source, GFile *destination,
+                   gboolean is_directory, goffset size)
+{
+        CopyTreeTask *task;
+
+        task = g_new0(CopyTreeTask, 1);
+        task->tree = tree;
+        task->source = source;
+        task->destination = destination;
+        task->is_directory = is_directory;
+        task->size = size;
+
+        return task;
+}
+
+static void
+copy_tree_task_free(gpointer data)
+{
+        CopyTreeTask *task = data;
+
+        g_object_unref(task->source);
+        g_object_unref(task->destination);
+        g_list_foreach(task->children, (GFunc)g_object_unref, NULL);
+        g_list_free(task->children);
+        g_free(task);
+}
+
+static void
+copy_tree_cancel(G_GNUC_UNUSED GCancellable *user_cancellable, gpointer data)
+{
+        g_cancellable_cancel(G_CANCELLABLE(data));
+}
+
+static void
+copy_tree_free(CopyTree *tree)
+{
+        g_queue_foreach(tree->tasks, (GFunc)copy_tree_task_free, NULL);
+        g_queue_free(tree->tasks);
+        if (tree->user_cancellable != NULL) {
+                g_cancellable_disconnect(tree->user_cancellable,
+                                         tree->cancelled_id);
+                g_object_unref(tree->user_cancellable);
+        }
+        g_object_unref(tree->cancellable);
+        g_object_unref(tree->result);
+        if (tree->error != NULL)
+                g_error_free(tree->error);
+        g_free(tree);
+}
+
+static VALUE
+copy_tree_progress_call(VALUE data)
+{
+        static ID s_id_call;
+        CopyTree *tree = (CopyTree *)data;
+        VALUE progress;
+
+        if (s_id_call == 0)
+                s_id_call = rb_intern("call");
+
+        progress = RARRAY_PTR(tree->callbacks)[1];
+        if (!NIL_P(progress))
+                rb_funcall(progress, s_id_call, 4,
+                           GUINT2RVAL(tree->n_files_done),
+                           GUINT2RVAL(tree->n_files),
+                           GOFFSET2RVAL(tree->n_bytes_done),
+                           GOFFSET2RVAL(tree->n_bytes));
+
+        return Qnil;
+}
+
+static void
+copy_tree_report_progress(CopyTree *tree, gboolean force)
+{
+        gint64 now;
+
+        if (NIL_P(RARRAY_PTR(tree->callbacks)[1]))
+                return;
+
+        now = g_get_monotonic_time();
+        if (!force && now - tree->last_progress < tree->progress_interval)
+                return;
+        tree->last_progress = now;
+
+        G_PROTECT_CALLBACK(copy_tree_progress_call, tree);
+}
+
+static void
+copy_tree_fail(CopyTree *tree, GError *error)
+{
+        if (tree->error != NULL) {
+                g_error_free(error);
+                return;
+        }
+
+        tree->error = error;
+        g_cancellable_cancel(tree->cancellable);
+}
+
+static VALUE
+copy_tree_ready_call(VALUE data)
+{
+        static ID s_id_call;
+        CopyTree *tree = (CopyTree *)data;
+        VALUE block;
+
+        if (s_id_call == 0)
+                s_id_call = rb_intern("call");
+
+        G_CHILD_REMOVE(mGLib, tree->callbacks);
+        block = RARRAY_PTR(tree->callbacks)[0];
+        if (!NIL_P(block))
+                rb_funcall(block, s_id_call, 1, GOBJ2RVAL(tree->result));
+
+        return Qnil;
+}
+
+static void
+copy_tree_ready(G_GNUC_UNUSED GObject *source,
+                G_GNUC_UNUSED GAsyncResult *result,
+                gpointer data)
+{
+        G_PROTECT_CALLBACK(copy_tree_ready_call, data);
+        copy_tree_free(data);
+}
+
+static void
+copy_tree_task_done(CopyTreeTask *task)
+{
+        CopyTree *tree = task->tree;
+
+        copy_tree_task_free(task);
+        tree->n_running--;
+        copy_tree_schedule(tree);
+}
+
+static void
+copy_tree_directory_thread(GSimpleAsyncResult *result,
+                           G_GNUC_UNUSED GObject *object,
+                           GCancellable *cancellable)
+{
+        CopyTreeTask *task;
+        GFileEnumerator *enumerator;
+        GFileInfo *info;
+        GError *error = NULL;
+
+        task = g_simple_async_result_get_op_res_gpointer(result);
+        enumerator = g_file_enumerate_children(task->source,
+                                               COPY_TREE_ATTRIBUTES,
+                                               G_FILE_QUERY_INFO_NOFOLLOW_SYMLINKS,
+                                               cancellable,
+                                               &error);
+        if (enumerator == NULL) {
+                g_simple_async_result_take_error(result, error);
+                return;
+        }
+
+        while ((info = g_file_enumerator_next_file(enumerator,
+                                                   cancellable,
+                                                   &error)) != NULL)
+                task->children = g_list_prepend(task->children, info);
+        g_file_enumerator_close(enumerator, NULL, NULL);
+        g_object_unref(enumerator);
+        if (error != NULL) {
+                g_simple_async_result_take_error(result, error);
+                return;
+        }
+
+        if (!g_file_make_directory(task->destination, cancellable, &error)) {
+                if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_EXISTS) &&
+                    (task->tree->flags & G_FILE_COPY_OVERWRITE)) {
+                        g_error_free(error);
+                } else {
+                        g_simple_async_result_take_error(result, error);
+                        return;
+                }
+        }
+}
+
+static void
+copy_tree_directory_ready(G_GNUC_UNUSED GObject *source,
+                          GAsyncResult *result,
+                          gpointer data)
+{
+        CopyTreeTask *task = data;
+        CopyTree *tree = task->tree;
+        GError *error = NULL;
+        GList *node;
+
+        if (g_simple_async_result_propagate_error(G_SIMPLE_ASYNC_RESULT(result),
+                                                  &error)) {
+                copy_tree_fail(tree, error);
+                copy_tree_task_done(task);
+                return;
+        }
+
+        for (node = task->children; node != NULL; node = node->next) {
+                GFileInfo *info = node->data;
+                const char *name = g_file_info_get_name(info);
+                gboolean is_directory;
+
+                is_directory = (g_file_info_get_file_type(info) ==
+                                G_FILE_TYPE_DIRECTORY);
+                g_queue_push_tail(tree->tasks,
+                                  copy_tree_task_new(tree,
+                                                     g_file_get_child(task->source, name),
+                                                     g_file_get_child(task->destination, name),
+                                                     is_directory,
+                                                     is_directory ? 0 : g_file_info_get_size(info)));
+                if (!is_directory) {
+                        tree->n_files++;
+                        tree->n_bytes += g_file_info_get_size(info);
+                }
+        }
+
+        copy_tree_task_done(task);
+}
+
+static void
+copy_tree_file_progress(goffset current_num_bytes,
+                        G_GNUC_UNUSED goffset total_num_bytes,
+                        gpointer data)
+{
+        CopyTreeTask *task = data;
+
+        task->tree->n_bytes_done += current_num_bytes - task->current_num_bytes;
+        task->current_num_bytes = current_num_bytes;
+        copy_tree_report_progress(task->tree, FALSE);
+}
+
+static void
+copy_tree_file_ready(GObject *source, GAsyncResult *result, gpointer data)
+{
+        CopyTreeTask *task = data;
+        CopyTree *tree = task->tree;
+        GError *error = NULL;
+
+        if (!g_file_copy_finish(G_FILE(source), result, &error)) {
+                copy_tree_fail(tree, error);
+        } else {
+                tree->n_files_done++;
+                tree->n_bytes_done += task->size - task->current_num_bytes;
+                copy_tree_report_progress(tree, FALSE);
+        }
+
+        copy_tree_task_done(task);
+}
+
+static void
+copy_tree_start_task(CopyTree *tree, CopyTreeTask *task)
+{
+        GSimpleAsyncResult *result;
+
+        tree->n_running++;
+        if (!task->is_directory) {
+                g_file_copy_async(task->source,
+                                  task->destination,
+                                  tree->flags | G_FILE_COPY_NOFOLLOW_SYMLINKS,
+                                  tree->io_priority,
+                                  tree->cancellable,
+                                  copy_tree_file_progress,
+                                  task,
+                                  copy_tree_file_ready,
+                                  task);
+                return;
+        }
+
+        result = g_simple_async_result_new(G_OBJECT(task->source),
+                                           copy_tree_directory_ready,
+                                           task,
+                                           copy_tree_start_task);
+        g_simple_async_result_set_op_res_gpointer(result, task, NULL);
+        g_simple_async_result_run_in_thread(result,
+                                            copy_tree_directory_thread,
+                                            tree->io_priority,
+                                            tree->cancellable);
+        g_object_unref(result);
+}
+
+static void
+copy_tree_schedule(CopyTree *tree)
+{
+        while (tree->error == NULL &&
+               tree->n_running < tree->jobs &&
+               !g_queue_is_empty(tree->tasks))
+                copy_tree_start_task(tree, g_queue_pop_head(tree->tasks));
+
+        if (tree->n_running > 0)
+                return;
+        if (tree->error == NULL && !g_queue_is_empty(tree->tasks))
+                return;
+
+        copy_tree_report_progress(tree, TRUE);
+        if (tree->error != NULL) {
+                g_simple_async_result_take_error(tree->result, tree->error);
+                tree->error = NULL;
+        } else {
+                g_simple_async_result_set_op_res_gssize(tree->result,
+                                                        tree->n_files_done);
+        }
+        g_simple_async_result_complete(tree->result);
+}
+
+/*
+ * copy_tree_async_raw(destination, flags, jobs, io_priority,
+ *                     cancellable, progress_interval, progress)
+ *                    {|result| ...}
+ *
+ * progress_interval is in milliseconds. progress is called with
+ * (n_files_done, n_files, n_bytes_done, n_bytes); n_files and n_bytes
+ * grow while directories are listed.
+ */
+static VALUE
+rg_copy_tree_async_raw(int argc, VALUE *argv, VALUE self)
+{
+        VALUE rbdestination, rbflags, rbjobs, rbio_priority, rbcancellable;
+        VALUE rbprogress_interval, rbprogress, block;
+        CopyTree *tree;
+        GFile *source, *destination;
+        GFileCopyFlags flags;
+        guint jobs;
+        int io_priority;
+        GCancellable *user_cancellable;
+        gint64 progress_interval;
+
+        rb_scan_args(argc, argv, "16&",
+                     &rbdestination, &rbflags, &rbjobs, &rbio_priority,
+                     &rbcancellable, &rbprogress_interval, &rbprogress,
+                     &block);
+
+        /* Everything that can raise comes before the first allocation. */
+        source = _SELF(self);
+        destination = _SELF(rbdestination);
+        flags = RVAL2GFILECOPYFLAGSDEFAULT(rbflags);
+        jobs = NIL_P(rbjobs) ? 4 : NUM2UINT(rbjobs);
+        if (jobs == 0)
+                jobs = 1;
+        io_priority = RVAL2IOPRIORITYDEFAULT(rbio_priority);
+        user_cancellable = RVAL2GCANCELLABLE(rbcancellable);
+        progress_interval = NIL_P(rbprogress_interval) ?
+                100 * 1000 :
+                (gint64)NUM2UINT(rbprogress_interval) * 1000;
+
+        tree = g_new0(CopyTree, 1);
+        tree->flags = flags;
+        tree->jobs = jobs;
+        tree->io_priority = io_priority;
+        tree->progress_interval = progress_interval;
+        tree->cancellable = g_cancellable_new();
+        tree->user_cancellable = user_cancellable;
+        if (tree->user_cancellable != NULL) {
+                g_object_ref(tree->user_cancellable);
+                tree->cancelled_id =
+                        g_cancellable_connect(tree->user_cancellable,
+                                              G_CALLBACK(copy_tree_cancel),
+                                              tree->cancellable,
+                                              NULL);
+        }
+        tree->tasks = g_queue_new();
+        tree->callbacks = rb_assoc_new(block, rbprogress);
+        G_CHILD_ADD(mGLib, tree->callbacks);
+
+        tree->result = g_simple_async_result_new(G_OBJECT(source),
+                                                 copy_tree_ready,
+                                                 tree,
+                                                 rg_copy_tree_async_raw);
+        g_queue_push_tail(tree->tasks,
+                          copy_tree_task_new(tree,
+                                             g_object_ref(source),
+                                             g_object_ref(destination),
+                                             TRUE,
+                                             0));
+        copy_tree_schedule(tree);
+
+        return self;
+}
+
+static VALUE
+rg_copy_tree_finish(VALUE self, VALUE result)
+{
+        GSimpleAsyncResult *simple;
+        GError *error = NULL;
+
+        if (!g_simple_async_result_is_valid(RVAL2GASYNCRESULT(result),
+                                            G_OBJECT(_SELF(self)),
+                                            rg_copy_tree_async_raw))
+                rb_raise(rb_eArgError, "result isn't from copy_tree_async");
+
+        simple = G_SIMPLE_ASYNC_RESULT(RVAL2GASYNCRESULT(result));
+        if (g_simple_async_result_propagate_error(simple, &error))
+                rbgio_raise_error(error);
+
+        return GSSIZE2RVAL(g_simple_async_result_get_op_res_gssize(simple));
+}
+
 void
 Init_gfile(VALUE mGio)
 {
@@ -1990,6 +2433,8 @@ Init_gfile(VALUE mGio)
         RG_DEF_METHOD(copy, -1);
         RG_DEF_METHOD(copy_async, -1);
         RG_DEF_METHOD(copy_finish, 1);
+        RG_DEF_METHOD(copy_tree_async_raw, -1);
+        RG_DEF_METHOD(copy_tree_finish, 1);
         RG_DEF_METHOD(move, -1);
         RG_DEF_METHOD(make_directory, -1);
         RG_DEF_METHOD(make_directory_with_parents, -1);
@@ -90,6 +90,184 @@ rg_next_files_finish(VALUE self, VALUE result)
         return GLIST2ARY_FREE(files);
 }
 
+/*
+ * Projection of GFileInfo to instances of a Ruby class (usually a
+ * Struct): each instance is created with the values of the projected
+ * attributes, in order, and the GFileInfo is released without ever
+ * being wrapped. Missing attributes are nil.
+ */
+struct file_info_projection
+{
+        const gchar **attributes;
+        long n_attributes;
+        VALUE klass;
+        VALUE *values;
+};
+
+static VALUE
+file_info_projection_attribute(GFileInfo *info, const gchar *attribute)
+{
+        GFileAttributeType type;
+        gpointer value;
+
+        if (!g_file_info_get_attribute_data(info, attribute, &type, &value, NULL))
+                return Qnil;
+
+        switch (type) {
+        case G_FILE_ATTRIBUTE_TYPE_STRING:
+        case G_FILE_ATTRIBUTE_TYPE_BYTE_STRING:
+                return CSTR2RVAL(value);
+        case G_FILE_ATTRIBUTE_TYPE_BOOLEAN:
+                return CBOOL2RVAL(*(gboolean *)value);
+        case G_FILE_ATTRIBUTE_TYPE_UINT32:
+                return GUINT322RVAL(*(guint32 *)value);
+        case G_FILE_ATTRIBUTE_TYPE_INT32:
+                return GINT322RVAL(*(gint32 *)value);
+        case G_FILE_ATTRIBUTE_TYPE_UINT64:
+                return GUINT642RVAL(*(guint64 *)value);
+        case G_FILE_ATTRIBUTE_TYPE_INT64:
+                return GINT642RVAL(*(gint64 *)value);
+        case G_FILE_ATTRIBUTE_TYPE_OBJECT:
+                return GOBJ2RVAL((GObject *)value);
+        case G_FILE_ATTRIBUTE_TYPE_STRINGV:
+                return STRV2RVAL((const gchar **)value);
+        default:
+                return Qnil;
+        }
+}
+
+static VALUE
+file_info_projection_apply(struct file_info_projection *projection,
+                           GFileInfo *info)
+{
+        long i;
+
+        for (i = 0; i < projection->n_attributes; i++)
+                projection->values[i] =
+                        file_info_projection_attribute(info,
+                                                       projection->attributes[i]);
+
+        return rb_class_new_instance((int)projection->n_attributes,
+                                     projection->values,
+                                     projection->klass);
+}
+
+struct next_files_projected_args
+{
+        struct file_info_projection projection;
+        VALUE rbattributes;
+        GList *infos;
+        VALUE result;
+};
+
+static VALUE
+next_files_projected_body(VALUE value)
+{
+        struct next_files_projected_args *args = (struct next_files_projected_args *)value;
+        GList *node;
+
+        args->projection.attributes = RVAL2STRS(args->rbattributes,
+                                                args->projection.n_attributes);
+        args->projection.values = ALLOCA_N(VALUE,
+                                           args->projection.n_attributes);
+        args->result = rb_ary_new2(g_list_length(args->infos));
+        for (node = args->infos; node != NULL; node = node->next)
+                rb_ary_push(args->result,
+                            file_info_projection_apply(&args->projection,
+                                                       node->data));
+
+        return args->result;
+}
+
+static VALUE
+next_files_projected_ensure(VALUE value)
+{
+        struct next_files_projected_args *args = (struct next_files_projected_args *)value;
+
+        g_list_foreach(args->infos, (GFunc)g_object_unref, NULL);
+        g_list_free(args->infos);
+        g_free(args->projection.attributes);
+
+        return Qnil;
+}
+
+static VALUE
+next_files_projected(GList *infos, VALUE rbattributes, VALUE klass)
+{
+        struct next_files_projected_args args;
+
+        args.infos = infos;
+        args.rbattributes = rbattributes;
+        args.result = Qnil;
+        args.projection.klass = klass;
+        args.projection.attributes = NULL;
+
+        return rb_ensure(next_files_projected_body, (VALUE)&args,
+                         next_files_projected_ensure, (VALUE)&args);
+}
+
+/*
+ * Gio::FileEnumerator#next_files_projected(num_files, attributes,
+ *                                          klass, cancellable=nil)
+ *
+ * Returns up to num_files entries as klass.new(*values), where values
+ * are the values of attributes. The Array is empty at the end.
+ */
+static VALUE
+rg_next_files_projected(int argc, VALUE *argv, VALUE self)
+{
+        VALUE rbnum_files, rbattributes, klass, rbcancellable;
+        GFileEnumerator *enumerator;
+        GCancellable *cancellable;
+        GList *infos = NULL;
+        GError *error = NULL;
+        int i, num_files;
+
+        rb_scan_args(argc, argv, "31", &rbnum_files, &rbattributes, &klass, &rbcancellable);
+        enumerator = _SELF(self);
+        num_files = NUM2INT(rbnum_files);
+        cancellable = RVAL2GCANCELLABLE(rbcancellable);
+        for (i = 0; i < num_files; i++) {
+                GFileInfo *info;
+
+                info = g_file_enumerator_next_file(enumerator, cancellable, &error);
+                if (info == NULL)
+                        break;
+                infos = g_list_prepend(infos, info);
+        }
+        infos = g_list_reverse(infos);
+        if (error != NULL) {
+                g_list_foreach(infos, (GFunc)g_object_unref, NULL);
+                g_list_free(infos);
+                rbgio_raise_error(error);
+        }
+
+        return next_files_projected(infos, rbattributes, klass);
+}
+
+/*
+ * Gio::FileEnumerator#next_files_projected_finish(result, attributes,
+ *                                                 klass)
+ *
+ * #next_files_finish for #next_files_async that returns projected
+ * entries like #next_files_projected.
+ */
+static VALUE
+rg_next_files_projected_finish(VALUE self, VALUE result,
+                               VALUE rbattributes, VALUE klass)
+{
+        GError *error = NULL;
+        GList *infos;
+
+        infos = g_file_enumerator_next_files_finish(_SELF(self),
+                                                    RVAL2GASYNCRESULT(result),
+                                                    &error);
+        if (error != NULL)
+                rbgio_raise_error(error);
+
+        return next_files_projected(infos, rbattributes, klass);
+}
+
 static VALUE
 rg_close_async(int argc, VALUE *argv, VALUE self)
 {
@@ -157,6 +335,8 @@ Init_gfileenumerator(VALUE mGio)
         RG_DEF_METHOD(close, -1);
         RG_DEF_METHOD(next_files_async, -1);
         RG_DEF_METHOD(next_files_finish, 1);
+        RG_DEF_METHOD(next_files_projected, -1);
+        RG_DEF_METHOD(next_files_projected_finish, 3);
         RG_DEF_METHOD(close_async, -1);
         RG_DEF_METHOD(close_finish, 1);
         RG_DEF_METHOD_P(closed, 0);
@@ -26,74 +26,191 @@
 
 static VALUE s_cReadAsyncResult;
 
+struct read_call
+{
+        RBGIOBlockingCall call;
+        GInputStream *stream;
+        void *buffer;
+        gsize count;
+        gssize bytes_read;
+};
+
+static RBGIO_BLOCKING_FUNC_RETURN_TYPE
+read_call_func(void *data)
+{
+        struct read_call *read = data;
+
+        read->bytes_read = g_input_stream_read(read->stream,
+                                               read->buffer,
+                                               read->count,
+                                               read->call.cancellable,
+                                               &read->call.error);
+
+        return RBGIO_BLOCKING_FUNC_RETURN_VALUE;
+}
+
 static VALUE
 rg_read(int argc, VALUE *argv, VALUE self)
 {
         VALUE rbcount, cancellable, result;
-        gsize count;
-        GError *error = NULL;
-        gssize bytes_read;
+        struct read_call read;
 
         rb_scan_args(argc, argv, "11", &rbcount, &cancellable);
-        count = RVAL2GSIZE(rbcount);
-        result = rb_str_new(NULL, count);
-        bytes_read = g_input_stream_read(_SELF(self),
-                                         RSTRING_PTR(result),
-                                         count,
-                                         RVAL2GCANCELLABLE(cancellable),
-                                         &error);
-        if (bytes_read == -1)
-                rbgio_raise_error(error);
-
-        rb_str_set_len(result, bytes_read);
-        rb_str_resize(result, bytes_read);
+        read.stream = _SELF(self);
+        read.count = RVAL2GSIZE(rbcount);
+        result = rb_str_new(NULL, read.count);
+        read.buffer = RSTRING_PTR(result);
+        rbgio_blocking_call(read_call_func, &read.call, cancellable);
+
+        rb_str_set_len(result, read.bytes_read);
+        rb_str_resize(result, read.bytes_read);
         OBJ_TAINT(result);
 
         return result;
 }
 
+struct read_all_call
+{
+        RBGIOBlockingCall call;
+        GInputStream *stream;
+        void *buffer;
+        gsize count;
+        gsize bytes_read;
+};
+
+static RBGIO_BLOCKING_FUNC_RETURN_TYPE
+read_all_call_func(void *data)
+{
+        struct read_all_call *read = data;
+
+        g_input_stream_read_all(read->stream,
+                                read->buffer,
+                                read->count,
+                                &read->bytes_read,
+                                read->call.cancellable,
+                                &read->call.error);
+
+        return RBGIO_BLOCKING_FUNC_RETURN_VALUE;
+}
+
 static VALUE
 rg_read_all(int argc, VALUE *argv, VALUE self)
 {
         VALUE rbcount, cancellable, result;
-        gsize count;
-        GError *error = NULL;
-        gsize bytes_read;
+        struct read_all_call read;
 
         rb_scan_args(argc, argv, "11", &rbcount, &cancellable);
-        count = RVAL2GSIZE(rbcount);
-        result = rb_str_new(NULL, count);
-        if (!g_input_stream_read_all(_SELF(self),
-                                     RSTRING_PTR(result),
-                                     count,
-                                     &bytes_read,
-                                     RVAL2GCANCELLABLE(cancellable),
-                                     &error))
-                rbgio_raise_error(error);
-
-        rb_str_set_len(result, bytes_read);
-        rb_str_resize(result, bytes_read);
+        read.stream = _SELF(self);
+        read.count = RVAL2GSIZE(rbcount);
+        result = rb_str_new(NULL, read.count);
+        read.buffer = RSTRING_PTR(result);
+        rbgio_blocking_call(read_all_call_func, &read.call, cancellable);
+
+        rb_str_set_len(result, read.bytes_read);
+        rb_str_resize(result, read.bytes_read);
         OBJ_TAINT(result);
 
         return result;
 }
 
+/*
+ * Gio::InputStream#read_into(buffer, count, options={})
+ *
+ * Reads up to count bytes into buffer at options[:offset] (0 by
+ * default) and truncates buffer to the end of the read data, like
+ * IO#readpartial with an output buffer. Returns the number of bytes
+ * read. options[:cancellable] is a Gio::Cancellable.
+ */
+static VALUE
+rg_read_into(int argc, VALUE *argv, VALUE self)
+{
+        VALUE rbbuffer, rbcount, options, rboffset, cancellable;
+        struct read_call read;
+        gsize offset;
+
+        rb_scan_args(argc, argv, "21", &rbbuffer, &rbcount, &options);
+        rbg_scan_options(options,
+                         "offset", &rboffset,
+                         "cancellable", &cancellable,
+                         NULL);
+        offset = NIL_P(rboffset) ? 0 : RVAL2GSIZE(rboffset);
+        read.stream = _SELF(self);
+        read.count = RVAL2GSIZE(rbcount);
+        read.buffer = rbgio_read_buffer_prepare(rbbuffer, offset, read.count);
+        rbgio_read_buffer_call(read_call_func, &read.call, cancellable,
+                               rbbuffer, offset);
+
+        rb_str_set_len(rbbuffer, offset + read.bytes_read);
+        OBJ_TAINT(rbbuffer);
+
+        return GSSIZE2RVAL(read.bytes_read);
+}
+
+/*
+ * Gio::InputStream#read_all_into(buffer, count, options={})
+ *
+ * Same as #read_into but keeps reading until count bytes are read or
+ * the end of the stream is reached.
+ */
+static VALUE
+rg_read_all_into(int argc, VALUE *argv, VALUE self)
+{
+        VALUE rbbuffer, rbcount, options, rboffset, cancellable;
+        struct read_all_call read;
+        gsize offset;
+
+        rb_scan_args(argc, argv, "21", &rbbuffer, &rbcount, &options);
+        rbg_scan_options(options,
+                         "offset", &rboffset,
+                         "cancellable", &cancellable,
+                         NULL);
+        offset = NIL_P(rboffset) ? 0 : RVAL2GSIZE(rboffset);
+        read.stream = _SELF(self);
+        read.count = RVAL2GSIZE(rbcount);
+        read.bytes_read = 0;
+        read.buffer = rbgio_read_buffer_prepare(rbbuffer, offset, read.count);
+        rbgio_read_buffer_call(read_all_call_func, &read.call, cancellable,
+                               rbbuffer, offset);
+
+        rb_str_set_len(rbbuffer, offset + read.bytes_read);
+        OBJ_TAINT(rbbuffer);
+
+        return GSIZE2RVAL(read.bytes_read);
+}
+
+struct skip_call
+{
+        RBGIOBlockingCall call;
+        GInputStream *stream;
+        gsize count;
+        gssize bytes_skipped;
+};
+
+static RBGIO_BLOCKING_FUNC_RETURN_TYPE
+skip_call_func(void *data)
+{
+        struct skip_call *skip = data;
+
+        skip->bytes_skipped = g_input_stream_skip(skip->stream,
+                                                  skip->count,
+                                                  skip->call.cancellable,
+                                                  &skip->call.error);
+
+        return RBGIO_BLOCKING_FUNC_RETURN_VALUE;
+}
+
 static VALUE
 rg_skip(int argc, VALUE *argv, VALUE self)
 {
         VALUE count, cancellable;
-        GError *error = NULL;
-        gssize bytes_skipped;
+        struct skip_call skip;
 
         rb_scan_args(argc, argv, "11", &count, &cancellable);
-        bytes_skipped = g_input_stream_skip(_SELF(self),
-                                            RVAL2GSIZE(count),
-                                            RVAL2GCANCELLABLE(cancellable),
-                                            &error);
-        if (bytes_skipped == -1)
-                rbgio_raise_error(error);
+        skip.stream = _SELF(self);
+        skip.count = RVAL2GSIZE(count);
+        rbgio_blocking_call(skip_call_func, &skip.call, cancellable);
 
-        return GSSIZE2RVAL(bytes_skipped);
+        return GSSIZE2RVAL(skip.bytes_skipped);
 }
 
 static VALUE
@@ -326,6 +443,8 @@ Init_ginputstream(VALUE mGio)
 
         RG_DEF_METHOD(read, -1);
         RG_DEF_METHOD(read_all, -1);
+        RG_DEF_METHOD(read_into, -1);
+        RG_DEF_METHOD(read_all_into, -1);
         RG_DEF_METHOD(skip, -1);
         RG_DEF_METHOD(close, -1);
         RG_DEF_METHOD(read_async, -1);
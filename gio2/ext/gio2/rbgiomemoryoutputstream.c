@@ -22,6 +22,7 @@
 #include "rbgio2private.h"
 
 #define RG_TARGET_NAMESPACE cMemoryOutputStream
+#define _SELF(value) RVAL2GMEMORYOUTPUTSTREAM(value)
 
 /* TODO: Take string argument? */
 static VALUE
@@ -35,10 +36,20 @@ rg_initialize(VALUE self)
         return Qnil;
 }
 
+static VALUE
+rg_data(VALUE self)
+{
+        GMemoryOutputStream *stream = _SELF(self);
+
+        return rb_str_new(g_memory_output_stream_get_data(stream),
+                          g_memory_output_stream_get_data_size(stream));
+}
+
 void
 Init_gmemoryoutputstream(VALUE mGio)
 {
         VALUE RG_TARGET_NAMESPACE = G_DEF_CLASS(G_TYPE_MEMORY_OUTPUT_STREAM, "MemoryOutputStream", mGio);
 
         RG_DEF_METHOD(initialize, 0);
+        RG_DEF_METHOD(data, 0);
 }
@@ -29,65 +29,125 @@
                                RVAL2GOUTPUTSTREAMSPLICEFLAGS, \
                                G_OUTPUT_STREAM_SPLICE_NONE)
 
+struct write_call
+{
+        RBGIOBlockingCall call;
+        GOutputStream *stream;
+        const void *buffer;
+        gsize count;
+        gssize bytes_written;
+};
+
+static RBGIO_BLOCKING_FUNC_RETURN_TYPE
+write_call_func(void *data)
+{
+        struct write_call *write = data;
+
+        write->bytes_written = g_output_stream_write(write->stream,
+                                                     write->buffer,
+                                                     write->count,
+                                                     write->call.cancellable,
+                                                     &write->call.error);
+
+        return RBGIO_BLOCKING_FUNC_RETURN_VALUE;
+}
+
 static VALUE
 rg_write(int argc, VALUE *argv, VALUE self)
 {
         VALUE rbbuffer, cancellable;
-        const char *buffer;
-        GError *error = NULL;
-        gssize bytes_written;
+        volatile VALUE frozen_buffer;
+        struct write_call write;
 
         rb_scan_args(argc, argv, "11", &rbbuffer, &cancellable);
-        buffer = RVAL2CSTR(rbbuffer);
-        bytes_written = g_output_stream_write(_SELF(self),
-                                              buffer,
-                                              (gsize)RSTRING_LEN(rbbuffer),
-                                              RVAL2GCANCELLABLE(cancellable),
-                                              &error);
-        if (bytes_written == -1)
-                rbgio_raise_error(error);
+        /* Other threads may modify rbbuffer while the GVL is released. */
+        frozen_buffer = rb_str_new_frozen(StringValue(rbbuffer));
+        write.stream = _SELF(self);
+        write.buffer = RSTRING_PTR(frozen_buffer);
+        write.count = (gsize)RSTRING_LEN(frozen_buffer);
+        rbgio_blocking_call(write_call_func, &write.call, cancellable);
+
+        return GSSIZE2RVAL(write.bytes_written);
+}
+
+struct write_all_call
+{
+        RBGIOBlockingCall call;
+        GOutputStream *stream;
+        const void *buffer;
+        gsize count;
+        gsize bytes_written;
+};
 
-        return GSSIZE2RVAL(bytes_written);
+static RBGIO_BLOCKING_FUNC_RETURN_TYPE
+write_all_call_func(void *data)
+{
+        struct write_all_call *write = data;
+
+        g_output_stream_write_all(write->stream,
+                                  write->buffer,
+                                  write->count,
+                                  &write->bytes_written,
+                                  write->call.cancellable,
+                                  &write->call.error);
+
+        return RBGIO_BLOCKING_FUNC_RETURN_VALUE;
 }
 
 static VALUE
 rg_write_all(int argc, VALUE *argv, VALUE self)
 {
         VALUE rbbuffer, cancellable;
-        const char *buffer;
-        gsize bytes_written;
-        GError *error = NULL;
+        volatile VALUE frozen_buffer;
+        struct write_all_call write;
 
         rb_scan_args(argc, argv, "11", &rbbuffer, &cancellable);
-        buffer = RVAL2CSTR(rbbuffer);
-        if (!g_output_stream_write_all(_SELF(self),
-                                       buffer,
-                                       (gsize)RSTRING_LEN(rbbuffer),
-                                       &bytes_written,
-                                       RVAL2GCANCELLABLE(cancellable),
-                                       &error))
-                rbgio_raise_error(error);
+        /* Other threads may modify rbbuffer while the GVL is released. */
+        frozen_buffer = rb_str_new_frozen(StringValue(rbbuffer));
+        write.stream = _SELF(self);
+        write.buffer = RSTRING_PTR(frozen_buffer);
+        write.count = (gsize)RSTRING_LEN(frozen_buffer);
+        rbgio_blocking_call(write_all_call_func, &write.call, cancellable);
+
+        return GSIZE2RVAL(write.bytes_written);
+}
+
+struct splice_call
+{
+        RBGIOBlockingCall call;
+        GOutputStream *stream;
+        GInputStream *source;
+        GOutputStreamSpliceFlags flags;
+        gssize bytes_spliced;
+};
+
+static RBGIO_BLOCKING_FUNC_RETURN_TYPE
+splice_call_func(void *data)
+{
+        struct splice_call *splice = data;
+
+        splice->bytes_spliced = g_output_stream_splice(splice->stream,
+                                                       splice->source,
+                                                       splice->flags,
+                                                       splice->call.cancellable,
+                                                       &splice->call.error);
 
-        return GSIZE2RVAL(bytes_written);
+        return RBGIO_BLOCKING_FUNC_RETURN_VALUE;
 }
 
 static VALUE
 rg_splice(int argc, VALUE *argv, VALUE self)
 {
         VALUE source, flags, cancellable;
-        GError *error = NULL;
-        gssize bytes_spliced;
+        struct splice_call splice;
 
         rb_scan_args(argc, argv, "12", &source, &flags, &cancellable);
-        bytes_spliced = g_output_stream_splice(_SELF(self),
-                                               RVAL2GINPUTSTREAM(source),
-                                               RVAL2GOUTPUTSTREAMSPLICEFLAGSDEFAULT(flags),
-                                               RVAL2GCANCELLABLE(cancellable),
-                                               &error);
-        if (bytes_spliced == -1)
-                rbgio_raise_error(error);
+        splice.stream = _SELF(self);
+        splice.source = RVAL2GINPUTSTREAM(source);
+        splice.flags = RVAL2GOUTPUTSTREAMSPLICEFLAGSDEFAULT(flags);
+        rbgio_blocking_call(splice_call_func, &splice.call, cancellable);
 
-        return GSSIZE2RVAL(bytes_spliced);
+        return GSSIZE2RVAL(splice.bytes_spliced);
 }
 
 typedef gboolean (*CancellableMethod)(GOutputStream *, GCancellable *, GError **);
@@ -117,6 +177,55 @@ rg_close(int argc, VALUE *argv, VALUE self)
         return cancellable_method(g_output_stream_close, argc, argv, self);
 }
 
+/*
+ * Async writes pin their source Strings: each one is replaced by a
+ * frozen String that shares its bytes (rb_str_new_frozen() doesn't
+ * copy non-embedded Strings) and is kept alive with the block until
+ * the operation completes. Modifying the caller's String afterwards
+ * copies it, not the bytes being written.
+ */
+static VALUE
+pin_buffer(VALUE rbbuffer)
+{
+        return rb_str_new_frozen(StringValue(rbbuffer));
+}
+
+struct write_async_callback_data
+{
+        GAsyncResult *result;
+        gpointer user_data;
+};
+
+static VALUE
+write_async_callback_call(VALUE data)
+{
+        static ID s_id_call;
+        struct write_async_callback_data *real;
+        VALUE pinned, block;
+
+        if (s_id_call == 0)
+                s_id_call = rb_intern("call");
+
+        real = (struct write_async_callback_data *)data;
+        pinned = (VALUE)real->user_data;
+        G_CHILD_REMOVE(mGLib, pinned);
+        block = RARRAY_PTR(pinned)[0];
+        if (!NIL_P(block))
+                rb_funcall(block, s_id_call, 1, GOBJ2RVAL_UNREF(real->result));
+
+        return Qnil;
+}
+
+static void
+write_async_callback(G_GNUC_UNUSED GObject *source,
+                     GAsyncResult *result,
+                     gpointer user_data)
+{
+        struct write_async_callback_data real = { result, user_data };
+
+        G_PROTECT_CALLBACK(write_async_callback_call, &real);
+}
+
 /* TODO: Does it make sense to use buffer and count?  We should probably
  * provide a better wrapper that simply pumps out buffer while count hasn't
  * been reached, calling the callback with the bytes written, then with the
@@ -124,29 +233,226 @@ rg_close(int argc, VALUE *argv, VALUE self)
 static VALUE
 rg_write_async(int argc, VALUE *argv, VALUE self)
 {
-        VALUE rbbuffer, rbcount, rbio_priority, rbcancellable, block;
-        const gchar *buffer;
+        VALUE rbbuffer, rbcount, rbio_priority, rbcancellable, block, pinned;
         gsize count;
         int io_priority;
         GCancellable *cancellable;
 
         rb_scan_args(argc, argv, "22&", &rbbuffer, &rbcount, &rbio_priority, &rbcancellable, &block);
-        buffer = RVAL2CSTR(rbbuffer);
+        rbbuffer = pin_buffer(rbbuffer);
         count = RVAL2GSIZE(rbcount);
+        if (count > (gsize)RSTRING_LEN(rbbuffer))
+                rb_raise(rb_eArgError,
+                         "count is larger than buffer: count: %" G_GSIZE_FORMAT
+                         ", buffer size: %ld",
+                         count, RSTRING_LEN(rbbuffer));
         io_priority = RVAL2IOPRIORITYDEFAULT(rbio_priority);
         cancellable = RVAL2GCANCELLABLE(rbcancellable);
-        SAVE_BLOCK(block);
+        pinned = rb_assoc_new(block, rbbuffer);
+        G_CHILD_ADD(mGLib, pinned);
         g_output_stream_write_async(_SELF(self),
-                                    buffer,
+                                    RSTRING_PTR(rbbuffer),
                                     count,
                                     io_priority,
                                     cancellable,
-                                    rbgio_async_ready_callback,
-                                    (gpointer)block);
+                                    write_async_callback,
+                                    (gpointer)pinned);
+
+        return self;
+}
+
+/*
+ * write_all_async writes a String or an Array of Strings as one
+ * operation. The buffers are written in order straight from the
+ * pinned Strings, without joining them first, by chaining
+ * g_output_stream_write_async() calls; the block receives a single
+ * result for the whole operation.
+ */
+struct write_all_async_vector
+{
+        const gchar *buffer;
+        gsize size;
+};
+
+struct write_all_async_data
+{
+        GSimpleAsyncResult *result;
+        GOutputStream *stream;
+        GCancellable *cancellable;
+        int io_priority;
+        VALUE pinned;
+        struct write_all_async_vector *vectors;
+        guint n_vectors;
+        guint index;
+        gsize offset;
+        gsize bytes_written;
+        gboolean synchronous;
+};
+
+static void write_all_async_next(struct write_all_async_data *data);
+
+static void
+write_all_async_data_free(struct write_all_async_data *data)
+{
+        g_object_unref(data->result);
+        g_object_unref(data->stream);
+        if (data->cancellable != NULL)
+                g_object_unref(data->cancellable);
+        g_free(data->vectors);
+        g_free(data);
+}
+
+static VALUE
+write_all_async_ready_call(VALUE value)
+{
+        static ID s_id_call;
+        struct write_all_async_data *data;
+        VALUE block;
+
+        if (s_id_call == 0)
+                s_id_call = rb_intern("call");
+
+        data = (struct write_all_async_data *)value;
+        G_CHILD_REMOVE(mGLib, data->pinned);
+        block = RARRAY_PTR(data->pinned)[0];
+        if (!NIL_P(block))
+                rb_funcall(block, s_id_call, 1, GOBJ2RVAL(data->result));
+
+        return Qnil;
+}
+
+static void
+write_all_async_ready(G_GNUC_UNUSED GObject *source,
+                      G_GNUC_UNUSED GAsyncResult *result,
+                      gpointer user_data)
+{
+        G_PROTECT_CALLBACK(write_all_async_ready_call, user_data);
+        write_all_async_data_free(user_data);
+}
+
+static void
+write_all_async_complete(struct write_all_async_data *data)
+{
+        /* Don't call the block before write_all_async returns. */
+        if (data->synchronous)
+                g_simple_async_result_complete_in_idle(data->result);
+        else
+                g_simple_async_result_complete(data->result);
+}
+
+static void
+write_all_async_wrote(G_GNUC_UNUSED GObject *source,
+                      GAsyncResult *result,
+                      gpointer user_data)
+{
+        struct write_all_async_data *data = user_data;
+        GError *error = NULL;
+        gssize bytes_written;
+
+        data->synchronous = FALSE;
+        bytes_written = g_output_stream_write_finish(data->stream,
+                                                     result,
+                                                     &error);
+        if (bytes_written == -1) {
+                g_simple_async_result_take_error(data->result, error);
+                write_all_async_complete(data);
+                return;
+        }
+
+        data->bytes_written += bytes_written;
+        data->offset += bytes_written;
+        write_all_async_next(data);
+}
+
+static void
+write_all_async_next(struct write_all_async_data *data)
+{
+        struct write_all_async_vector *vector;
+
+        while (data->index < data->n_vectors &&
+               data->offset == data->vectors[data->index].size) {
+                data->index++;
+                data->offset = 0;
+        }
+
+        if (data->index == data->n_vectors) {
+                g_simple_async_result_set_op_res_gssize(data->result,
+                                                        data->bytes_written);
+                write_all_async_complete(data);
+                return;
+        }
+
+        vector = &data->vectors[data->index];
+        g_output_stream_write_async(data->stream,
+                                    vector->buffer + data->offset,
+                                    vector->size - data->offset,
+                                    data->io_priority,
+                                    data->cancellable,
+                                    write_all_async_wrote,
+                                    data);
+}
+
+static VALUE
+rg_write_all_async(int argc, VALUE *argv, VALUE self)
+{
+        VALUE rbbuffers, rbbuffers_array, rbio_priority, rbcancellable, block, pinned;
+        struct write_all_async_data *data;
+        GCancellable *cancellable;
+        long i, n;
+
+        rb_scan_args(argc, argv, "12&", &rbbuffers, &rbio_priority, &rbcancellable, &block);
+        rbbuffers_array = rb_check_array_type(rbbuffers);
+        if (NIL_P(rbbuffers_array))
+                rbbuffers_array = rb_ary_new3(1, rbbuffers);
+        n = RARRAY_LEN(rbbuffers_array);
+        pinned = rb_ary_new2(n + 1);
+        rb_ary_push(pinned, block);
+        for (i = 0; i < n; i++)
+                rb_ary_push(pinned, pin_buffer(RARRAY_PTR(rbbuffers_array)[i]));
+        cancellable = RVAL2GCANCELLABLE(rbcancellable);
+
+        data = g_new0(struct write_all_async_data, 1);
+        data->stream = g_object_ref(_SELF(self));
+        data->cancellable = cancellable ? g_object_ref(cancellable) : NULL;
+        data->io_priority = RVAL2IOPRIORITYDEFAULT(rbio_priority);
+        data->pinned = pinned;
+        data->n_vectors = (guint)n;
+        data->vectors = g_new(struct write_all_async_vector, n);
+        for (i = 0; i < n; i++) {
+                VALUE rbbuffer = RARRAY_PTR(pinned)[i + 1];
+
+                data->vectors[i].buffer = RSTRING_PTR(rbbuffer);
+                data->vectors[i].size = (gsize)RSTRING_LEN(rbbuffer);
+        }
+        data->result = g_simple_async_result_new(G_OBJECT(data->stream),
+                                                 write_all_async_ready,
+                                                 data,
+                                                 rg_write_all_async);
+        data->synchronous = TRUE;
+        G_CHILD_ADD(mGLib, pinned);
+        write_all_async_next(data);
 
         return self;
 }
 
+static VALUE
+rg_write_all_finish(VALUE self, VALUE result)
+{
+        GSimpleAsyncResult *simple;
+        GError *error = NULL;
+
+        if (!g_simple_async_result_is_valid(RVAL2GASYNCRESULT(result),
+                                            G_OBJECT(_SELF(self)),
+                                            rg_write_all_async))
+                rb_raise(rb_eArgError, "result isn't from write_all_async");
+
+        simple = G_SIMPLE_ASYNC_RESULT(RVAL2GASYNCRESULT(result));
+        if (g_simple_async_result_propagate_error(simple, &error))
+                rbgio_raise_error(error);
+
+        return GSSIZE2RVAL(g_simple_async_result_get_op_res_gssize(simple));
+}
+
 typedef gssize (*SSizeFinishMethod)(GOutputStream *, GAsyncResult *, GError **);
 
 static VALUE
@@ -317,6 +623,8 @@ Init_goutputstream(VALUE mGio)
         RG_DEF_METHOD(close, -1);
         RG_DEF_METHOD(write_async, -1);
         RG_DEF_METHOD(write_finish, 1);
+        RG_DEF_METHOD(write_all_async, -1);
+        RG_DEF_METHOD(write_all_finish, 1);
         RG_DEF_METHOD(splice_async, -1);
         RG_DEF_METHOD(splice_finish, 1);
         RG_DEF_METHOD(flush_async, -1);
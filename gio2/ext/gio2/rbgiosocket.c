@@ -157,6 +157,63 @@ rg_receive(int argc, VALUE *argv, VALUE self)
         return result;
 }
 
+struct receive_call
+{
+        RBGIOBlockingCall call;
+        GSocket *socket;
+        gchar *buffer;
+        gsize size;
+        gssize bytes_received;
+};
+
+static RBGIO_BLOCKING_FUNC_RETURN_TYPE
+receive_call_func(void *data)
+{
+        struct receive_call *receive = data;
+
+        receive->bytes_received = g_socket_receive(receive->socket,
+                                                   receive->buffer,
+                                                   receive->size,
+                                                   receive->call.cancellable,
+                                                   &receive->call.error);
+
+        return RBGIO_BLOCKING_FUNC_RETURN_VALUE;
+}
+
+/*
+ * Gio::Socket#receive_into(buffer, bytes, options={})
+ *
+ * Receives up to bytes bytes into buffer at options[:offset] (0 by
+ * default) without allocating a new String. See
+ * Gio::InputStream#read_into.
+ */
+static VALUE
+rg_receive_into(int argc, VALUE *argv, VALUE self)
+{
+        VALUE rbbuffer, rbbytes, options, rboffset, cancellable;
+        struct receive_call receive;
+        gsize offset;
+
+        rb_scan_args(argc, argv, "21", &rbbuffer, &rbbytes, &options);
+        rbg_scan_options(options,
+                         "offset", &rboffset,
+                         "cancellable", &cancellable,
+                         NULL);
+        offset = NIL_P(rboffset) ? 0 : RVAL2GSIZE(rboffset);
+        receive.socket = _SELF(self);
+        receive.size = RVAL2GSIZE(rbbytes);
+        receive.buffer = rbgio_read_buffer_prepare(rbbuffer,
+                                                   offset,
+                                                   receive.size);
+        rbgio_read_buffer_call(receive_call_func, &receive.call, cancellable,
+                               rbbuffer, offset);
+
+        rb_str_set_len(rbbuffer, offset + receive.bytes_received);
+        OBJ_TAINT(rbbuffer);
+
+        return GSSIZE2RVAL(receive.bytes_received);
+}
+
 static VALUE
 rg_receive_from(int argc, VALUE *argv, VALUE self)
 {
@@ -374,6 +431,7 @@ Init_gsocket(VALUE mGio)
         RG_DEF_METHOD(connect, -1);
         RG_DEF_METHOD(check_connect_result, 0);
         RG_DEF_METHOD(receive, -1);
+        RG_DEF_METHOD(receive_into, -1);
         RG_DEF_METHOD(receive_from, -1);
         RG_DEF_METHOD(send, -1);
         RG_DEF_METHOD(send_to, -1);
@@ -237,6 +237,183 @@ rbgio_child_remove_and_return(VALUE parent, VALUE child)
         return child;
 }
 
+static void
+rbgio_blocking_call_unblock(void *data)
+{
+        g_cancellable_cancel(G_CANCELLABLE(data));
+}
+
+static void
+rbgio_blocking_call_forward_cancel(G_GNUC_UNUSED GCancellable *source,
+                                   gpointer data)
+{
+        g_cancellable_cancel(G_CANCELLABLE(data));
+}
+
+struct blocking_call_data {
+        RBGIOBlockingFunc func;
+        RBGIOBlockingCall *call;
+        GCancellable *user_cancellable;
+        gulong handler_id;
+        gboolean done;
+};
+
+static VALUE
+rbgio_blocking_call_body(VALUE value)
+{
+        struct blocking_call_data *data = (struct blocking_call_data *)value;
+
+        rb_thread_call_without_gvl(data->func, data->call,
+                                   rbgio_blocking_call_unblock,
+                                   data->call->cancellable);
+        data->done = TRUE;
+
+        return Qnil;
+}
+
+static VALUE
+rbgio_blocking_call_ensure(VALUE value)
+{
+        struct blocking_call_data *data = (struct blocking_call_data *)value;
+        RBGIOBlockingCall *call = data->call;
+
+        if (data->handler_id > 0)
+                g_cancellable_disconnect(data->user_cancellable,
+                                         data->handler_id);
+        g_object_unref(call->cancellable);
+        call->cancellable = NULL;
+
+        /* An interrupt is propagating: it wins over the error, which
+         * is usually the "cancelled" it caused. */
+        if (!data->done && call->error) {
+                g_error_free(call->error);
+                call->error = NULL;
+        }
+
+        return Qnil;
+}
+
+/*
+ * Runs func without the GVL so that other Ruby threads keep running
+ * while it blocks. func must not touch Ruby objects; it reports
+ * failures through call->error. call->cancellable is a private
+ * cancellable that follows rbcancellable and is cancelled when Ruby
+ * interrupts the thread (Thread#kill, Timeout, signals), so the
+ * blocking GIO call returns promptly without cancelling the caller's
+ * cancellable. The pending interrupt is raised when func returns; the
+ * cancellables and call->error are cleaned up in any case.
+ */
+void
+rbgio_blocking_call(RBGIOBlockingFunc func,
+                    RBGIOBlockingCall *call,
+                    VALUE rbcancellable)
+{
+        struct blocking_call_data data;
+
+        data.func = func;
+        data.call = call;
+        data.user_cancellable = RVAL2GCANCELLABLE(rbcancellable);
+        data.handler_id = 0;
+        data.done = FALSE;
+
+        call->cancellable = g_cancellable_new();
+        call->error = NULL;
+        if (data.user_cancellable)
+                data.handler_id =
+                        g_cancellable_connect(data.user_cancellable,
+                                              G_CALLBACK(rbgio_blocking_call_forward_cancel),
+                                              call->cancellable,
+                                              NULL);
+
+        rb_ensure(rbgio_blocking_call_body, (VALUE)&data,
+                  rbgio_blocking_call_ensure, (VALUE)&data);
+
+        if (call->error)
+                rbgio_raise_error(call->error);
+}
+
+/*
+ * Grows rbbuffer so that count bytes fit at offset and returns the
+ * address to read into. offset must not be past the end of the
+ * current contents; the contents before offset are kept. The
+ * capacity of rbbuffer is reused, so passing the same String to
+ * every read doesn't allocate.
+ */
+char *
+rbgio_read_buffer_prepare(VALUE rbbuffer, gsize offset, gsize count)
+{
+        StringValue(rbbuffer);
+        rb_str_modify(rbbuffer);
+        if (offset > (gsize)RSTRING_LEN(rbbuffer))
+                rb_raise(rb_eArgError,
+                         "offset is out of buffer: offset: %" G_GSIZE_FORMAT
+                         ", buffer size: %ld",
+                         offset, RSTRING_LEN(rbbuffer));
+        if (count > G_MAXLONG - offset)
+                rb_raise(rb_eArgError,
+                         "count is too large: %" G_GSIZE_FORMAT, count);
+        if (offset + count > (gsize)RSTRING_LEN(rbbuffer))
+                rb_str_resize(rbbuffer, offset + count);
+
+        return RSTRING_PTR(rbbuffer) + offset;
+}
+
+struct read_buffer_call_args
+{
+        RBGIOBlockingFunc func;
+        RBGIOBlockingCall *call;
+        VALUE rbcancellable;
+        VALUE rbbuffer;
+        gsize offset;
+};
+
+static VALUE
+read_buffer_call_body(VALUE data)
+{
+        struct read_buffer_call_args *args = (struct read_buffer_call_args *)data;
+
+        rbgio_blocking_call(args->func, args->call, args->rbcancellable);
+
+        return Qnil;
+}
+
+static VALUE
+read_buffer_call_ensure(VALUE data)
+{
+        struct read_buffer_call_args *args = (struct read_buffer_call_args *)data;
+
+        rb_str_unlocktmp(args->rbbuffer);
+        /* The caller extends this to the read data on success. */
+        rb_str_set_len(args->rbbuffer, args->offset);
+
+        return Qnil;
+}
+
+/*
+ * rbgio_blocking_call() for reads into a String prepared by
+ * rbgio_read_buffer_prepare(). The String is locked while the GVL is
+ * released so that other threads can't reallocate it under the read,
+ * and is truncated to offset afterwards.
+ */
+void
+rbgio_read_buffer_call(RBGIOBlockingFunc func,
+                       RBGIOBlockingCall *call,
+                       VALUE rbcancellable,
+                       VALUE rbbuffer,
+                       gsize offset)
+{
+        struct read_buffer_call_args args;
+
+        args.func = func;
+        args.call = call;
+        args.rbcancellable = rbcancellable;
+        args.rbbuffer = rbbuffer;
+        args.offset = offset;
+        rb_str_locktmp(rbbuffer);
+        rb_ensure(read_buffer_call_body, (VALUE)&args,
+                  read_buffer_call_ensure, (VALUE)&args);
+}
+
 VALUE
 rbgio_define_domain_error(VALUE module,
                           const char *name,
@@ -12,6 +12,7 @@ rescue LoadError
 end
 
 require "gio2/deprecated"
+require "gio2/future"
 
 class Gio::DataInputStream
   include Enumerable
@@ -75,6 +76,171 @@ module Gio::File
     end
     self
   end
+
+  class << self
+    # Returns a Struct class whose members are the given file
+    # attributes, e.g. "standard::content-type" is #content_type. The
+    # first member is always #name ("standard::name").
+    def child_struct(attributes)
+      attributes = (["standard::name"] + attributes.to_a).uniq
+      @child_structs ||= {}
+      @child_structs[attributes] ||= create_child_struct(attributes)
+    end
+
+    private
+    def create_child_struct(attributes)
+      members = attributes.collect do |attribute|
+        attribute.sub(/\A.*::/, "").tr("-", "_")
+      end
+      members = members.each_with_index.collect do |member, i|
+        if members.count(member) > 1
+          attributes[i].gsub(/::|-/, "_")
+        else
+          member
+        end
+      end
+      struct = Struct.new(*members.collect {|member| member.to_sym})
+      struct.const_set(:ATTRIBUTES, attributes.freeze)
+      struct.const_set(:QUERY, attributes.join(",").freeze)
+      struct
+    end
+  end
+
+  # Yields the children in Arrays of at most options[:batch_size] (100
+  # by default) Structs that have only the requested attributes. See
+  # Gio::File.child_struct. No Gio::FileInfo is created.
+  def each_child_batch(attributes, options = {})
+    unless block_given?
+      return to_enum(:each_child_batch, attributes, options)
+    end
+    struct = Gio::File.child_struct(attributes)
+    batch_size = options[:batch_size] || 100
+    cancellable = options[:cancellable]
+    enumerator = enumerate_children(struct::QUERY, options[:flags], cancellable)
+    begin
+      loop do
+        children = enumerator.next_files_projected(batch_size,
+                                                   struct::ATTRIBUTES,
+                                                   struct,
+                                                   cancellable)
+        break if children.empty?
+        yield children
+      end
+    ensure
+      enumerator.close(cancellable)
+    end
+    self
+  end
+
+  # Asynchronous #each_child_batch on top of #next_files_async.
+  # Returns a Gio::Future resolved with self when all children are
+  # yielded.
+  def each_child_batch_async(attributes, options = {}, &block)
+    struct = Gio::File.child_struct(attributes)
+    batch_size = options[:batch_size] || 100
+    io_priority = options[:io_priority] || GLib::PRIORITY_DEFAULT
+    cancellable = options[:cancellable]
+    future = Gio::Future.new(cancellable)
+    enumerate_children_async(struct::QUERY, options[:flags],
+                             io_priority, cancellable) do |result|
+      begin
+        enumerator = enumerate_children_finish(result)
+      rescue StandardError => error
+        future.reject(error)
+      else
+        each_child_batch_async_loop(enumerator, struct, batch_size,
+                                    io_priority, cancellable, future, block)
+      end
+    end
+    future
+  end
+
+  # Yields (parent, child) for every descendant, depth first, where
+  # child is a Struct like #each_child_batch. Symbolic links aren't
+  # followed unless options[:flags] says otherwise.
+  def walk(attributes, options = {}, &block)
+    unless block_given?
+      return to_enum(:walk, attributes, options)
+    end
+    attributes = ["standard::type"] | attributes.to_a
+    options = {
+      :flags => Gio::File::QueryInfoFlags::NOFOLLOW_SYMLINKS,
+    }.merge(options)
+    directory = Gio::File::Type::DIRECTORY.to_i
+    each_child_batch(attributes, options) do |children|
+      children.each do |child|
+        yield(self, child)
+        if child.type == directory
+          get_child(child.name).walk(attributes, options, &block)
+        end
+      end
+    end
+    self
+  end
+
+  # Copies the directory tree rooted at self to destination with at
+  # most options[:jobs] (4 by default) copies and listings running on
+  # GIO's worker threads at once. options[:progress] is called with
+  # (n_files_done, n_files, n_bytes_done, n_bytes) at most once per
+  # options[:progress_interval] seconds (0.1 by default) and once at
+  # the end. options[:cancellable] cancels the whole copy. Calls the
+  # block with the result for #copy_tree_finish, or returns a
+  # Gio::Future resolved with the number of copied files without a
+  # block.
+  def copy_tree_async(destination, options = {}, &block)
+    cancellable = options[:cancellable]
+    interval = options[:progress_interval]
+    interval = (interval * 1000).round if interval
+    future = nil
+    unless block
+      future = Gio::Future.new(cancellable)
+      block = lambda do |result|
+        begin
+          future.resolve(copy_tree_finish(result))
+        rescue StandardError => error
+          future.reject(error)
+        end
+      end
+    end
+    copy_tree_async_raw(destination, options[:flags], options[:jobs],
+                        options[:io_priority], cancellable, interval,
+                        options[:progress], &block)
+    future || self
+  end
+
+  # Synchronous #copy_tree_async: iterates the default main context
+  # until the copy is done and returns the number of copied files. The
+  # block, if any, is used as options[:progress].
+  def copy_tree(destination, options = {}, &progress)
+    options = options.merge(:progress => progress) if progress
+    copy_tree_async(destination, options).wait
+  end
+
+  private :copy_tree_async_raw
+
+  private
+  def each_child_batch_async_loop(enumerator, struct, batch_size,
+                                  io_priority, cancellable, future, block)
+    enumerator.next_files_async(batch_size, io_priority, cancellable) do |result|
+      begin
+        children = enumerator.next_files_projected_finish(result,
+                                                          struct::ATTRIBUTES,
+                                                          struct)
+        block.call(children) unless children.empty?
+      rescue StandardError => error
+        enumerator.close_async(io_priority)
+        future.reject(error)
+      else
+        if children.empty?
+          enumerator.close_async(io_priority)
+          future.resolve(self)
+        else
+          each_child_batch_async_loop(enumerator, struct, batch_size,
+                                      io_priority, cancellable, future, block)
+        end
+      end
+    end
+  end
 end
 
 class Gio::FileEnumerator
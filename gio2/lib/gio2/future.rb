@@ -0,0 +1,264 @@
+module Gio
+  # A Gio::Future is the eventual result of an asynchronous GIO
+  # operation. It is resolved from the main loop by the operation's
+  # GAsyncReadyCallback, so callbacks registered with #then and
+  # #rescue run in the main loop too.
+  #
+  #   file.query_info_async("standard::size").then do |info|
+  #     info.size
+  #   end
+  class Future
+    attr_reader :value, :error, :cancellable
+
+    def initialize(cancellable = nil)
+      @cancellable = cancellable
+      @state = :pending
+      @value = nil
+      @error = nil
+      @callbacks = []
+    end
+
+    def pending?
+      @state == :pending
+    end
+
+    def resolved?
+      @state == :resolved
+    end
+
+    def rejected?
+      @state == :rejected
+    end
+
+    def resolve(value)
+      complete(:resolved, value, nil)
+    end
+
+    def reject(error)
+      complete(:rejected, nil, error)
+    end
+
+    # Returns a new Future resolved with the value of the block, which
+    # is called with the value of this Future. The block may return a
+    # Future to chain another asynchronous operation.
+    def then(&block)
+      chain(block, nil)
+    end
+
+    # Returns a new Future resolved with the value of the block, which
+    # is called with the error when this Future is rejected.
+    def rescue(&block)
+      chain(nil, block)
+    end
+
+    # Calls the block with the Future itself once it is completed.
+    def on_complete(&block)
+      if pending?
+        @callbacks << block
+      else
+        block.call(self)
+      end
+      self
+    end
+
+    def cancel
+      @cancellable.cancel if @cancellable
+      self
+    end
+
+    # Iterates context until this Future is completed and returns its
+    # value or raises its error.
+    def wait(context = GLib::MainContext.default)
+      context.iteration(true) while pending?
+      raise @error if rejected?
+      @value
+    end
+
+    protected
+    def state
+      @state
+    end
+
+    def complete(state, value, error)
+      return self unless pending?
+      @state = state
+      @value = value
+      @error = error
+      callbacks, @callbacks = @callbacks, []
+      callbacks.each do |callback|
+        callback.call(self)
+      end
+      self
+    end
+
+    def adopt(value)
+      if value.is_a?(Future)
+        value.on_complete do |completed|
+          complete(completed.state, completed.value, completed.error)
+        end
+      else
+        resolve(value)
+      end
+    end
+
+    private
+    def chain(on_resolved, on_rejected)
+      future = Future.new(@cancellable)
+      on_complete do |completed|
+        handler = completed.resolved? ? on_resolved : on_rejected
+        if handler.nil?
+          future.complete(completed.state, completed.value, completed.error)
+        else
+          begin
+            argument = completed.resolved? ? completed.value : completed.error
+            future.adopt(handler.call(argument))
+          rescue StandardError => error
+            future.reject(error)
+          end
+        end
+      end
+      future
+    end
+  end
+
+  class << self
+    # Returns a Future resolved with the values of futures, in order,
+    # once all of them are resolved, or rejected with the first error.
+    def all(futures)
+      futures = futures.to_a
+      future = Future.new
+      values = Array.new(futures.size)
+      n_pending = futures.size
+      future.resolve(values) if n_pending.zero?
+      futures.each_with_index do |each_future, i|
+        each_future.on_complete do |completed|
+          if completed.rejected?
+            future.reject(completed.error)
+          else
+            values[i] = completed.value
+            n_pending -= 1
+            future.resolve(values) if n_pending.zero?
+          end
+        end
+      end
+      future
+    end
+
+    # Calls the block with each item, which must start an operation
+    # and return a Future for it, with at most options[:concurrency]
+    # (64 by default) operations in flight. Returns a Future resolved
+    # with the values in the order of items, or rejected with the first
+    # error; no new operation is started after an error.
+    def map_async(items, options = {}, &block)
+      items = items.to_a
+      concurrency = options[:concurrency] || 64
+      if concurrency < 1
+        raise ArgumentError, "concurrency must be positive: #{concurrency}"
+      end
+
+      future = Future.new
+      values = Array.new(items.size)
+      next_index = 0
+      n_running = 0
+      # Futures that are already resolved call on_complete right away.
+      # Their completions only update the counters while the loop is
+      # running and the loop picks up the next item, so that a long run
+      # of them doesn't nest a start call per item.
+      running = false
+      start = nil
+      # A lambda so that each completion gets its own i; the while loop
+      # below doesn't open a new scope.
+      watch = lambda do |i, item_future|
+        item_future.on_complete do |completed|
+          n_running -= 1
+          if completed.rejected?
+            future.reject(completed.error)
+          else
+            values[i] = completed.value
+            if next_index == items.size and n_running.zero?
+              future.resolve(values)
+            elsif not running
+              start.call
+            end
+          end
+        end
+      end
+      start = lambda do
+        running = true
+        begin
+          while future.pending? and n_running < concurrency and
+              next_index < items.size
+            i = next_index
+            next_index += 1
+            n_running += 1
+            begin
+              item_future = block.call(items[i])
+            rescue StandardError => error
+              future.reject(error)
+              break
+            end
+            watch.call(i, item_future)
+          end
+        ensure
+          running = false
+        end
+      end
+      if items.empty?
+        future.resolve(values)
+      else
+        start.call
+      end
+      future
+    end
+  end
+
+  module File
+    # *_async methods that return a Gio::Future resolved with the value
+    # of the matching *_finish method when they are called without a
+    # block.
+    FUTURE_ASYNC_METHODS = [
+      :read,
+      :append_to,
+      :create,
+      :replace,
+      :query_info,
+      :query_filesystem_info,
+      :find_enclosing_mount,
+      :enumerate_children,
+      :set_display_name,
+      :copy,
+      :set_attributes,
+      :load_contents,
+      :replace_contents,
+      :create_readwrite,
+      :open_readwrite,
+      :replace_readwrite,
+    ]
+
+    FUTURE_ASYNC_METHODS.each do |name|
+      async_name = "#{name}_async"
+      finish_name = "#{name}_finish"
+      raw_async_name = "#{async_name}_without_future"
+      next unless method_defined?(async_name)
+
+      alias_method raw_async_name, async_name
+      private raw_async_name
+      define_method(async_name) do |*args, &block|
+        return __send__(raw_async_name, *args, &block) if block
+
+        future = Future.new(args.find {|arg| arg.is_a?(Gio::Cancellable)})
+        # copy_async also calls the block with progress as
+        # (current_num_bytes, total_num_bytes).
+        __send__(raw_async_name, *args) do |*results|
+          next unless results.size == 1
+          begin
+            future.resolve(__send__(finish_name, results[0]))
+          rescue StandardError => error
+            future.reject(error)
+          end
+        end
+        future
+      end
+    end
+  end
+end
@@ -0,0 +1,86 @@
+# -*- coding: utf-8 -*-
+
+require "tmpdir"
+require "fileutils"
+
+class TestFile < Test::Unit::TestCase
+  def setup
+    @dir = Dir.mktmpdir
+    FileUtils.mkdir_p(File.join(@dir, "sub"))
+    File.open(File.join(@dir, "a.txt"), "w") {|file| file.print("abc")}
+    File.open(File.join(@dir, "sub", "b.txt"), "w") {|file| file.print("de")}
+    @file = Gio::File.new_for_path(@dir)
+  end
+
+  def teardown
+    FileUtils.rm_rf(@dir)
+  end
+
+  def test_child_struct
+    struct = Gio::File.child_struct(["standard::size",
+                                     "standard::content-type"])
+    assert_equal([:name, :size, :content_type], struct.members.collect(&:to_sym))
+  end
+
+  def test_each_child_batch
+    batches = []
+    @file.each_child_batch(["standard::size"], :batch_size => 1) do |children|
+      batches << children
+    end
+    assert_equal([1, 1], batches.collect(&:size))
+    children = batches.flatten.sort_by(&:name)
+    assert_equal([["a.txt", 3], "sub"],
+                 [[children[0].name, children[0].size], children[1].name])
+  end
+
+  def test_each_child_batch_async
+    names = []
+    future = @file.each_child_batch_async([]) do |children|
+      names.concat(children.collect(&:name))
+    end
+    assert_equal(@file, future.wait)
+    assert_equal(["a.txt", "sub"], names.sort)
+  end
+
+  def test_walk
+    paths = []
+    @file.walk(["standard::size"]) do |parent, child|
+      paths << parent.get_child(child.name).path.sub(@dir + "/", "")
+    end
+    assert_equal(["a.txt", "sub", "sub/b.txt"], paths.sort)
+  end
+
+  def test_copy_tree
+    destination = Gio::File.new_for_path(File.join(@dir, "copy"))
+    progress = []
+    n_files = @file.get_child("sub").copy_tree(destination, :jobs => 2) do |*args|
+      progress << args
+    end
+    assert_equal([1, "de", [1, 1, 2, 2]],
+                 [n_files,
+                  File.read(File.join(@dir, "copy", "b.txt")),
+                  progress.last])
+  end
+
+  def test_copy_tree_error
+    destination = Gio::File.new_for_path(File.join(@dir, "sub"))
+    assert_raise(Gio::IO::ExistsError) do
+      @file.get_child("sub").copy_tree(destination)
+    end
+  end
+
+  def test_copy_tree_async_invalid_destination
+    assert_raise(TypeError) do
+      @file.get_child("sub").copy_tree_async(File.join(@dir, "copy")) {}
+    end
+  end
+
+  def test_copy_tree_async_invalid_cancellable
+    destination = Gio::File.new_for_path(File.join(@dir, "copy"))
+    assert_raise(TypeError) do
+      @file.get_child("sub").copy_tree_async(destination,
+                                             :cancellable => "cancel") {}
+    end
+    assert_false(File.exist?(File.join(@dir, "copy")))
+  end
+end
@@ -0,0 +1,81 @@
+# -*- coding: utf-8 -*-
+
+class TestFuture < Test::Unit::TestCase
+  def test_then
+    future = Gio::Future.new
+    chained = future.then {|value| value * 2}
+    future.resolve(21)
+    assert_equal(42, chained.value)
+  end
+
+  def test_then_future
+    future = Gio::Future.new
+    inner = Gio::Future.new
+    chained = future.then {|value| inner}
+    future.resolve(1)
+    assert_true(chained.pending?)
+    inner.resolve(2)
+    assert_equal(2, chained.value)
+  end
+
+  def test_rescue
+    future = Gio::Future.new
+    chained = future.then {|value| raise "not reached"}.rescue do |error|
+      error.message
+    end
+    future.reject(RuntimeError.new("failed"))
+    assert_equal("failed", chained.value)
+  end
+
+  class Stop < Exception
+  end
+
+  def test_then_not_standard_error
+    future = Gio::Future.new
+    chained = future.then {|value| raise Stop}
+    assert_raise(Stop) do
+      future.resolve(1)
+    end
+    assert_true(chained.pending?)
+  end
+
+  def test_all
+    futures = [Gio::Future.new, Gio::Future.new]
+    all = Gio.all(futures)
+    futures[1].resolve(2)
+    futures[0].resolve(1)
+    assert_equal([1, 2], all.value)
+  end
+
+  def test_map_async_concurrency
+    futures = []
+    mapped = Gio.map_async([1, 2, 3], :concurrency => 2) do |item|
+      future = Gio::Future.new
+      futures << [future, item]
+      future
+    end
+    assert_equal(2, futures.size)
+    futures.shift.tap {|future, item| future.resolve(item * 10)}
+    assert_equal(2, futures.size)
+    futures.each {|future, item| future.resolve(item * 10)}
+    assert_equal([10, 20, 30], mapped.value)
+  end
+
+  def test_map_async_resolved_futures
+    items = (0...100_000).to_a
+    mapped = Gio.map_async(items) do |item|
+      future = Gio::Future.new
+      future.resolve(item)
+      future
+    end
+    assert_equal(items, mapped.value)
+  end
+
+  def test_file_query_info_async
+    file = Gio::File.new_for_path(__FILE__)
+    size = file.query_info_async("standard::size").then do |info|
+      info.size
+    end
+    assert_equal(File.size(__FILE__), size.wait)
+  end
+end
@@ -0,0 +1,33 @@
+# -*- coding: utf-8 -*-
+
+class TestInputStream < Test::Unit::TestCase
+  def setup
+    @stream = Gio::MemoryInputStream.new("abcdefghij")
+  end
+
+  def test_read_into
+    buffer = "XXXXXXXXXXXXXXXX"
+    assert_equal(4, @stream.read_into(buffer, 4))
+    assert_equal("abcd", buffer)
+  end
+
+  def test_read_into_offset
+    buffer = "0123"
+    assert_equal(3, @stream.read_into(buffer, 3, :offset => 2))
+    assert_equal("01abc", buffer)
+  end
+
+  def test_read_into_offset_out_of_buffer
+    assert_raise(ArgumentError) do
+      @stream.read_into("", 3, :offset => 1)
+    end
+  end
+
+  def test_read_all_into
+    buffer = ""
+    assert_equal(10, @stream.read_all_into(buffer, 16))
+    assert_equal("abcdefghij", buffer)
+    assert_equal(0, @stream.read_all_into(buffer, 16))
+    assert_equal("", buffer)
+  end
+end
@@ -0,0 +1,47 @@
+# -*- coding: utf-8 -*-
+
+class TestOutputStream < Test::Unit::TestCase
+  def setup
+    @stream = Gio::MemoryOutputStream.new
+    @context = GLib::MainContext.default
+  end
+
+  def test_write_all_async
+    buffers = ["ab", "", "cde"]
+    bytes_written = nil
+    @stream.write_all_async(buffers) do |result|
+      bytes_written = @stream.write_all_finish(result)
+    end
+    buffers.each {|buffer| buffer.replace("XXXX")}
+    @context.iteration(true) while bytes_written.nil?
+    assert_equal([5, 5, "abcde"],
+                 [bytes_written, @stream.data_size, @stream.data])
+  end
+
+  def test_write_all_async_empty
+    bytes_written = nil
+    @stream.write_all_async([]) do |result|
+      bytes_written = @stream.write_all_finish(result)
+    end
+    assert_nil(bytes_written)
+    @context.iteration(true) while bytes_written.nil?
+    assert_equal(0, bytes_written)
+  end
+
+  def test_write_async_mutated_buffer
+    buffer = "abcde"
+    bytes_written = nil
+    @stream.write_async(buffer, 3) do |result|
+      bytes_written = @stream.write_finish(result)
+    end
+    buffer.replace("XXXXXXXXXX")
+    @context.iteration(true) while bytes_written.nil?
+    assert_equal([3, "abc"], [bytes_written, @stream.data])
+  end
+
+  def test_write_async_too_large_count
+    assert_raise(ArgumentError) do
+      @stream.write_async("abc", 4) {}
+    end
+  end
+end
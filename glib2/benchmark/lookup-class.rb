@@ -0,0 +1,55 @@
+#!/usr/bin/env ruby
+#
+# Copyright (C) 2013  Ruby-GNOME2 Project Team
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+# Measures GType to Ruby class lookup throughput, which is on the path
+# of every GOBJ2RVAL/GVAL2RVAL conversion, from a single thread and
+# from several threads at once.
+#
+#   % ruby -I glib2/lib -I glib2/ext/glib2 \
+#       glib2/benchmark/lookup-class.rb [N_LOOKUPS] [N_THREADS]
+
+require "benchmark"
+require "glib2"
+
+n_lookups = Integer(ARGV[0] || 1_000_000)
+n_threads = Integer(ARGV[1] || 4)
+
+types = [
+  GLib::Type["GObject"],
+  GLib::Type["GParam"],
+  GLib::Type["GClosure"],
+]
+n_lookups_per_thread = n_lookups / n_threads
+
+Benchmark.bmbm do |benchmark|
+  benchmark.report("GLib::Type#to_class") do
+    n_lookups.times do |i|
+      types[i % types.size].to_class
+    end
+  end
+  benchmark.report("#{n_threads} threads") do
+    threads = n_threads.times.collect do
+      Thread.new do
+        n_lookups_per_thread.times do |i|
+          types[i % types.size].to_class
+        end
+      end
+    end
+    threads.each(&:join)
+  end
+end
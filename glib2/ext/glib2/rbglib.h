@@ -47,6 +47,10 @@ extern "C" {
 #  define RARRAY_LEN(s) (RARRAY(s)->len)
 #endif
 
+#ifndef RHASH_SIZE
+#  define RHASH_SIZE(h) (RHASH(h)->tbl->num_entries)
+#endif
+
 #ifndef DBL2NUM
 #  define DBL2NUM(v)      (rb_float_new(v))
 #endif
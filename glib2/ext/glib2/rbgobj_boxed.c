@@ -25,6 +25,8 @@
 
 VALUE RG_TARGET_NAMESPACE;
 
+static GStaticPrivate borrow_scope_key = G_STATIC_PRIVATE_INIT;
+
 static void
 boxed_mark(boxed_holder *holder)
 {
@@ -67,10 +69,21 @@ rbgobj_boxed_s_allocate(VALUE klass)
     holder->type  = cinfo->gtype;
     holder->boxed = NULL;
     holder->own   = FALSE;
+    holder->borrowed = FALSE;
 
     return result;
 }
 
+static void
+boxed_check_expired(VALUE obj, boxed_holder *holder)
+{
+    if (holder->borrowed && !holder->boxed)
+        rb_raise(rb_eRuntimeError,
+                 "borrowed %s is used after its callback returned: "
+                 "use #dup in the callback to keep it",
+                 rb_class2name(CLASS_OF(obj)));
+}
+
 static G_GNUC_NORETURN VALUE
 rg_initialize(VALUE self)
 {
@@ -87,11 +100,12 @@ rg_inspect(VALUE self)
 
     Data_Get_Struct(self, boxed_holder, holder);
 
-    s = g_strdup_printf("#<%s:%p ptr=%p own=%s>",
+    s = g_strdup_printf("#<%s:%p ptr=%p own=%s%s>",
                         rb_class2name(CLASS_OF(self)),
                         (void *)self,
                         holder->boxed,
-                        holder->own ? "true" : "false");
+                        holder->own ? "true" : "false",
+                        holder->borrowed ? " borrowed" : "");
 
     result = rb_str_new2(s);
     g_free(s);
@@ -113,9 +127,11 @@ rg_initialize_copy(VALUE self, VALUE orig)
 
     Data_Get_Struct(self, boxed_holder, holder1);
     Data_Get_Struct(orig, boxed_holder, holder2);
+    boxed_check_expired(orig, holder2);
 
     holder1->boxed = g_boxed_copy(holder2->type, holder2->boxed);
     holder1->own   = TRUE;
+    holder1->borrowed = FALSE;
 
     if (!holder1->boxed)
       rb_raise(rb_eRuntimeError, "g_boxed_copy() failed");
@@ -141,23 +157,31 @@ rbgobj_boxed_initialize(VALUE obj, gpointer boxed)
     holder->own   = TRUE;
 }
 
+/* obj must be a GLib::Boxed: its class isn't checked. */
 gpointer
-rbgobj_boxed_get_default(VALUE obj, GType gtype)
+rbgobj_boxed_peek(VALUE obj)
 {
     boxed_holder *holder;
 
-    if (!RVAL2CBOOL(rb_obj_is_kind_of(obj, GTYPE2CLASS(gtype))))
-        rb_raise(rb_eArgError, "invalid argument %s (expect %s)",
-                 rb_class2name(CLASS_OF(obj)),
-                 rb_class2name(GTYPE2CLASS(gtype)));
-
     Data_Get_Struct(obj, boxed_holder, holder);
+    boxed_check_expired(obj, holder);
     if (!holder->boxed)
         rb_raise(rb_eArgError, "uninitialize %s", rb_class2name(CLASS_OF(obj)));
 
     return holder->boxed;
 }
 
+gpointer
+rbgobj_boxed_get_default(VALUE obj, GType gtype)
+{
+    if (!RVAL2CBOOL(rb_obj_is_kind_of(obj, GTYPE2CLASS(gtype))))
+        rb_raise(rb_eArgError, "invalid argument %s (expect %s)",
+                 rb_class2name(CLASS_OF(obj)),
+                 rb_class2name(GTYPE2CLASS(gtype)));
+
+    return rbgobj_boxed_peek(obj);
+}
+
 gpointer
 rbgobj_boxed_get(VALUE obj, GType gtype)
 {
@@ -225,6 +249,17 @@ rbgobj_boxed_not_copy_obj(GType gtype)
     cinfo->flags |= RBGOBJ_BOXED_NOT_COPY;
 }
 
+void
+rbgobj_boxed_borrow_in_callbacks(GType gtype, gboolean borrow)
+{
+    RGObjClassInfo *cinfo = (RGObjClassInfo *)GTYPE2CINFO(gtype);
+
+    if (borrow)
+        cinfo->flags |= RBGOBJ_BOXED_BORROW;
+    else
+        cinfo->flags &= ~RBGOBJ_BOXED_BORROW;
+}
+
 void
 rbgobj_boxed_unown(VALUE boxed)
 {
@@ -243,14 +278,97 @@ rbgobj_boxed_unown(VALUE boxed)
 
 /**********************************************************************/
 
+void
+rbgobj_boxed_borrow_scope_push(RGBoxedBorrowScope *scope)
+{
+    scope->wrappers = Qnil;
+    scope->converting = FALSE;
+    scope->previous = g_static_private_get(&borrow_scope_key);
+    g_static_private_set(&borrow_scope_key, scope, NULL);
+}
+
+void
+rbgobj_boxed_borrow_scope_pop(RGBoxedBorrowScope *scope)
+{
+    long i;
+
+    g_static_private_set(&borrow_scope_key, scope->previous, NULL);
+    if (NIL_P(scope->wrappers))
+        return;
+
+    for (i = 0; i < RARRAY_LEN(scope->wrappers); i++) {
+        boxed_holder *holder;
+
+        Data_Get_Struct(RARRAY_PTR(scope->wrappers)[i], boxed_holder, holder);
+        holder->boxed = NULL;
+    }
+}
+
+static VALUE
+boxed_borrow(gpointer boxed, GType gtype, RGBoxedBorrowScope *scope)
+{
+    const RGObjClassInfo *cinfo;
+    boxed_holder *holder;
+    VALUE result;
+
+    cinfo = GTYPE2CINFO(gtype);
+    if (!(cinfo->flags & RBGOBJ_BOXED_BORROW))
+        return Qundef;
+
+    result = rbgobj_make_boxed_raw(boxed, gtype, cinfo->klass,
+                                   RBGOBJ_BOXED_NOT_COPY);
+    Data_Get_Struct(result, boxed_holder, holder);
+    holder->borrowed = TRUE;
+    if (NIL_P(scope->wrappers))
+        scope->wrappers = rb_ary_new();
+    rb_ary_push(scope->wrappers, result);
+
+    return result;
+}
+
 static VALUE
 boxed_to_ruby(const GValue *from)
 {
     gpointer boxed;
+    RGBoxedBorrowScope *scope;
+
     boxed = g_value_get_boxed(from);
+    scope = g_static_private_get(&borrow_scope_key);
+    if (boxed && scope && scope->converting) {
+        VALUE result;
+
+        result = boxed_borrow(boxed, G_VALUE_TYPE(from), scope);
+        if (result != Qundef)
+            return result;
+    }
     return rbgobj_make_boxed(boxed, G_VALUE_TYPE(from));
 }
 
+static VALUE
+rg_s_set_borrow_in_callbacks(VALUE self, VALUE borrow)
+{
+    rbgobj_boxed_borrow_in_callbacks(CLASS2GTYPE(self), RVAL2CBOOL(borrow));
+
+    return borrow;
+}
+
+static VALUE
+rg_s_borrow_in_callbacks_p(VALUE self)
+{
+    const RGObjClassInfo *cinfo = CLASS2CINFO(self);
+
+    return CBOOL2RVAL(cinfo->flags & RBGOBJ_BOXED_BORROW);
+}
+
+static VALUE
+rg_borrowed_p(VALUE self)
+{
+    boxed_holder *holder;
+
+    Data_Get_Struct(self, boxed_holder, holder);
+    return CBOOL2RVAL(holder->borrowed);
+}
+
 static void
 boxed_from_ruby(VALUE from, GValue *to)
 {
@@ -272,8 +390,12 @@ Init_gobject_gboxed(void)
     rb_define_alloc_func(RG_TARGET_NAMESPACE, (VALUE(*)_((VALUE)))rbgobj_boxed_s_allocate);
     rbg_define_singleton_method(RG_TARGET_NAMESPACE, "gtype", generic_s_gtype, 0);
     rbg_define_method(RG_TARGET_NAMESPACE, "gtype", generic_gtype, 0);
+    rb_define_singleton_method(RG_TARGET_NAMESPACE, "borrow_in_callbacks=",
+                               rg_s_set_borrow_in_callbacks, 1);
+    RG_DEF_SMETHOD_P(borrow_in_callbacks, 0);
     RG_DEF_METHOD(initialize, 0);
     RG_DEF_METHOD(inspect, 0);
+    RG_DEF_METHOD_P(borrowed, 0);
     RG_DEF_METHOD(initialize_copy, 1);
     RG_DEF_ALIAS("copy", "dup");
 }
@@ -59,6 +59,7 @@ struct marshal_arg
     const GValue*   param_values;
     gpointer        invocation_hint;
     gpointer        marshal_data;
+    RGBoxedBorrowScope *borrow_scope;
 };
 
 static int
@@ -67,8 +68,57 @@ rclosure_alive_p(GRClosure *rclosure)
     return (rclosure->count > 0 && !NIL_P(rclosure->rb_holder));
 }
 
+/* Emissions with at most this many arguments (signal parameters plus
+ * extra_args) are dispatched from a stack buffer without building an
+ * argument Array. */
+#define MARSHAL_N_STACK_ARGS 16
+
 static VALUE
-rclosure_marshal_do(VALUE arg_)
+rclosure_call(GRClosure *rclosure, guint n_param_values,
+              const GValue *param_values, RGBoxedBorrowScope *borrow_scope)
+{
+    VALUE callback, extra_args;
+    long n_extra_args = 0;
+    VALUE args;
+
+    callback = rclosure->callback;
+    extra_args = rclosure->extra_args;
+    if (!NIL_P(extra_args))
+        n_extra_args = RARRAY_LEN(extra_args);
+
+    if (!rclosure->g2r_func &&
+        n_param_values + n_extra_args <= MARSHAL_N_STACK_ARGS) {
+        VALUE argv[MARSHAL_N_STACK_ARGS];
+        guint i;
+        long j;
+
+        borrow_scope->converting = TRUE;
+        for (i = 0; i < n_param_values; i++)
+            argv[i] = GVAL2RVAL(&param_values[i]);
+        borrow_scope->converting = FALSE;
+        for (j = 0; j < n_extra_args; j++)
+            argv[n_param_values + j] = RARRAY_PTR(extra_args)[j];
+
+        return rb_funcall2(callback, id_call,
+                           (int)(n_param_values + n_extra_args), argv);
+    }
+
+    borrow_scope->converting = TRUE;
+    if (rclosure->g2r_func) {
+        args = rclosure->g2r_func(n_param_values, param_values);
+    } else {
+        args = rclosure_default_g2r_func(n_param_values, param_values);
+    }
+    borrow_scope->converting = FALSE;
+    if (!NIL_P(extra_args)) {
+        args = rb_ary_concat(args, extra_args);
+    }
+
+    return rb_apply(callback, id_call, args);
+}
+
+static VALUE
+rclosure_marshal_body(VALUE arg_)
 {
     struct marshal_arg *arg;
     GRClosure*      rclosure;
@@ -79,8 +129,6 @@ rclosure_marshal_do(VALUE arg_)
     /* gpointer        marshal_data; */
 
     VALUE ret = Qnil;
-    VALUE args;
-    GValToRValSignalFunc func;
 
     arg = (struct marshal_arg*)arg_;
     rclosure        = (GRClosure *)(arg->closure);
@@ -90,23 +138,9 @@ rclosure_marshal_do(VALUE arg_)
     /* invocation_hint = arg->invocation_hint; */
     /* marshal_data    = arg->marshal_data; */
 
-    if (rclosure->g2r_func){
-        func = (GValToRValSignalFunc)rclosure->g2r_func;
-    } else { 
-        func = (GValToRValSignalFunc)rclosure_default_g2r_func;
-    }
-    args = (*func)(n_param_values, param_values);
-
     if (rclosure_alive_p(rclosure)) {
-        VALUE callback, extra_args;
-        callback = rclosure->callback;
-        extra_args = rclosure->extra_args;
-
-        if (!NIL_P(extra_args)) {
-            args = rb_ary_concat(args, extra_args);
-        }
-
-        ret = rb_apply(callback, id_call, args);
+        ret = rclosure_call(rclosure, n_param_values, param_values,
+                            arg->borrow_scope);
     } else {
         rb_warn("GRClosure invoking callback: already destroyed: %s",
                 rclosure->tag[0] ? rclosure->tag : "(anonymous)");
@@ -118,6 +152,29 @@ rclosure_marshal_do(VALUE arg_)
     return Qnil;
 }
 
+static VALUE
+rclosure_marshal_ensure(VALUE arg_)
+{
+    struct marshal_arg *arg = (struct marshal_arg *)arg_;
+
+    rbgobj_boxed_borrow_scope_pop(arg->borrow_scope);
+    return Qnil;
+}
+
+/* Boxed arguments of classes that borrow in callbacks are wrapped
+ * without copying and expire when the callback returns. */
+static VALUE
+rclosure_marshal_do(VALUE arg_)
+{
+    struct marshal_arg *arg = (struct marshal_arg *)arg_;
+    RGBoxedBorrowScope borrow_scope;
+
+    arg->borrow_scope = &borrow_scope;
+    rbgobj_boxed_borrow_scope_push(&borrow_scope);
+    return rb_ensure(rclosure_marshal_body, arg_,
+                     rclosure_marshal_ensure, arg_);
+}
+
 static void
 rclosure_marshal(GClosure*       closure,
                  GValue*         return_value,
@@ -101,9 +101,116 @@ rbgobj_add_constants(VALUE mod, GType type, const gchar *strip_prefix)
     }
 }
 
+/*
+ * Each enum/flags class keeps a value => instance table and a name =>
+ * instance table in hidden instance variables, so that converting a
+ * value or a Symbol/String name to an instance is a Hash lookup that
+ * doesn't allocate. Both tables are filled when the class is
+ * initialized. Interned instances are shared, so they are frozen.
+ */
+static ID id_values;
+static ID id_names;
+
+static VALUE
+rg_enum_table_get(VALUE klass, ID id)
+{
+    if (!rb_ivar_defined(klass, id))
+        return Qnil;
+    return rb_ivar_get(klass, id);
+}
+
+void
+rg_enum_table_init(VALUE klass)
+{
+    rb_ivar_set(klass, id_values, rb_hash_new());
+    rb_ivar_set(klass, id_names, rb_hash_new());
+}
+
+VALUE
+rg_enum_table_lookup(VALUE klass, VALUE number)
+{
+    VALUE values;
+
+    values = rg_enum_table_get(klass, id_values);
+    if (NIL_P(values))
+        return Qnil;
+    return rb_hash_lookup(values, number);
+}
+
+gboolean
+rg_enum_table_add(VALUE klass, VALUE number, VALUE instance, long max_size)
+{
+    VALUE values;
+
+    values = rg_enum_table_get(klass, id_values);
+    if (NIL_P(values))
+        return FALSE;
+    if (max_size >= 0 && (long)RHASH_SIZE(values) >= max_size)
+        return FALSE;
+    rb_obj_freeze(instance);
+    rb_hash_aset(values, number, instance);
+    return TRUE;
+}
+
+static void
+rg_enum_table_add_name_variant(VALUE names, const gchar *name, VALUE instance)
+{
+    VALUE key;
+
+    key = rb_obj_freeze(rb_str_new2(name));
+    if (NIL_P(rb_hash_lookup(names, key)))
+        rb_hash_aset(names, key, instance);
+    key = ID2SYM(rb_intern(name));
+    if (NIL_P(rb_hash_lookup(names, key)))
+        rb_hash_aset(names, key, instance);
+}
+
+void
+rg_enum_table_add_name(VALUE klass, const gchar *nick, VALUE instance)
+{
+    VALUE names;
+    gchar *name;
+    gchar *p;
+
+    names = rg_enum_table_get(klass, id_names);
+    if (NIL_P(names) || !nick)
+        return;
+
+    rg_enum_table_add_name_variant(names, nick, instance);
+
+    name = g_strdup(nick);
+    for (p = name; *p; p++) {
+        if (*p == '-' || *p == ' ')
+            *p = '_';
+    }
+    rg_enum_table_add_name_variant(names, name, instance);
+    for (p = name; *p; p++) {
+        *p = g_ascii_toupper(*p);
+    }
+    rg_enum_table_add_name_variant(names, name, instance);
+    g_free(name);
+}
+
+VALUE
+rg_enum_table_lookup_name(VALUE klass, VALUE name)
+{
+    VALUE names;
+
+    if (!SYMBOL_P(name) && TYPE(name) != T_STRING)
+        return Qnil;
+
+    names = rg_enum_table_get(klass, id_names);
+    if (NIL_P(names))
+        return Qnil;
+    return rb_hash_lookup(names, name);
+}
+
 void
 Init_gobject_genumflags(void)
 {
+    id_values = rb_intern("__values__");
+    id_names = rb_intern("__names__");
+
     Init_gobject_genums();
     Init_gobject_gflags();
 }
@@ -61,6 +61,10 @@ rg_enum_resolve_value(VALUE klass, VALUE nick)
     if (RVAL2CBOOL(rb_obj_is_kind_of(nick, klass)))
         return nick;
 
+    value = rg_enum_table_lookup_name(klass, nick);
+    if (!NIL_P(value))
+        return value;
+
     nick = rb_funcall(nick, id_to_s, 0);
     const_nick = nick_to_const_name(RVAL2CSTR(nick));
     const_nick_id = rb_intern(const_nick);
@@ -123,7 +127,13 @@ enum_get_holder(VALUE obj)
 static VALUE
 make_enum(gint n, VALUE klass)
 {
-    return rb_funcall(klass, id_new, 1, INT2NUM(n));
+    VALUE number = INT2NUM(n);
+    VALUE value;
+
+    value = rg_enum_table_lookup(klass, number);
+    if (NIL_P(value))
+        value = rb_funcall(klass, id_new, 1, number);
+    return value;
 }
 
 VALUE
@@ -171,9 +181,15 @@ rbgobj_init_enum_class(VALUE klass)
     GEnumClass* gclass = g_type_class_ref(CLASS2GTYPE(klass));
     guint i;
 
+    rg_enum_table_init(klass);
     for (i = 0; i < gclass->n_values; i++) {
         GEnumValue* entry = &(gclass->values[i]);
         gchar *const_nick_name;
+        VALUE value;
+
+        value = make_enum(entry->value, klass);
+        rg_enum_table_add(klass, INT2NUM(entry->value), value, -1);
+        rg_enum_table_add_name(klass, entry->value_nick, value);
 
         const_nick_name = nick_to_const_name(entry->value_nick);
 
@@ -181,18 +197,12 @@ rbgobj_init_enum_class(VALUE klass)
         {
             ID id = rb_intern(const_nick_name);
             if (rb_is_const_id(id)) {
-                VALUE value;
-
-                value = make_enum(entry->value, klass);
                 rb_define_const(klass, const_nick_name, value);
             }
         }
 #else
         {
             if (const_nick_name) {
-                VALUE value;
-
-                value = make_enum(entry->value, klass);
                 rbgobj_define_const(klass, const_nick_name, value);
             }
         }
@@ -31,6 +31,10 @@ static ID id_new;
 static ID id_module_eval;
 static ID id_or;
 
+/* Combinations that aren't defined values are interned too, up to this
+ * number of instances per class. */
+#define FLAGS_TABLE_MAX_SIZE 256
+
 /**********************************************************************/
 
 static VALUE
@@ -109,7 +113,15 @@ flags_get_holder(VALUE obj)
 static VALUE
 make_flags(guint n, VALUE klass)
 {
-    return rb_funcall(klass, id_new, 1, UINT2NUM(n));
+    VALUE number = UINT2NUM(n);
+    VALUE value;
+
+    value = rg_enum_table_lookup(klass, number);
+    if (NIL_P(value)) {
+        value = rb_funcall(klass, id_new, 1, number);
+        rg_enum_table_add(klass, number, value, FLAGS_TABLE_MAX_SIZE);
+    }
+    return value;
 }
 
 VALUE
@@ -157,11 +169,16 @@ rbgobj_init_flags_class(VALUE klass)
     GString* source = g_string_new(NULL);
     guint i;
 
+    rg_enum_table_init(klass);
     for (i = 0; i < gclass->n_values; i++) {
         GFlagsValue* entry = &(gclass->values[i]);
         gchar* nick;
         gchar* p;
         gchar* replace_nick;
+        VALUE value;
+
+        value = make_flags(entry->value, klass);
+        rg_enum_table_add_name(klass, entry->value_nick, value);
 
         replace_nick = rg_obj_constant_lookup(entry->value_nick);
         if (replace_nick){
@@ -189,12 +206,12 @@ rbgobj_init_flags_class(VALUE klass)
         {
             ID id = rb_intern(nick);
             if (rb_is_const_id(id)) {
-                rb_define_const(klass, nick, make_flags(entry->value, klass));
+                rb_define_const(klass, nick, value);
             }
         }
 #else
         {
-            rbgobj_define_const(klass, nick, make_flags(entry->value, klass));
+            rbgobj_define_const(klass, nick, value);
         }
 #endif
 
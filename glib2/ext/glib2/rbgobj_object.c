@@ -413,6 +413,115 @@ gobj_s_properties(int argc, VALUE* argv, VALUE self)
 static VALUE type_to_prop_setter_table;
 static VALUE type_to_prop_getter_table;
 
+typedef struct {
+    GParamSpec *pspec;
+    RValueToGValueFunc setter;
+    GValueToRValueFunc getter;
+    ID id_child;
+    guint serial;
+} PropertyCacheEntry;
+
+static GQuark q_property_cache;
+static guint property_cache_serial = 0;
+
+static void
+property_cache_entry_free(gpointer data)
+{
+    PropertyCacheEntry *entry = data;
+
+    g_param_spec_unref(entry->pspec);
+    g_free(entry);
+}
+
+static gpointer
+property_lookup_converter(VALUE type_to_table, GParamSpec *pspec)
+{
+    VALUE table;
+    gpointer func = NULL;
+
+    table = rb_hash_aref(type_to_table, INT2FIX(pspec->owner_type));
+    if (!NIL_P(table)) {
+        VALUE obj = rb_hash_aref(table, CSTR2RVAL(g_param_spec_get_name(pspec)));
+        if (!NIL_P(obj))
+            Data_Get_Struct(obj, void, func);
+    }
+
+    return func;
+}
+
+static GParamSpec *
+property_find(GObject *gobj, const char *name)
+{
+    GParamSpec *pspec;
+
+    pspec = g_object_class_find_property(G_OBJECT_GET_CLASS(gobj), name);
+    if (!pspec)
+        rb_raise(eNoPropertyError, "No such property: %s", name);
+    return pspec;
+}
+
+/*
+ * Resolves a property name to its GParamSpec and registered converters.
+ * Results are cached per GType and keyed by the name's ID, so repeated
+ * accesses through a Symbol or an already interned name don't allocate
+ * strings or consult the converter tables again. Names that aren't
+ * interned yet are resolved into uncached without creating an ID, so
+ * arbitrary Strings never become immortal Symbols.
+ */
+static PropertyCacheEntry *
+property_cache_lookup(GObject *gobj, VALUE prop_name,
+                      PropertyCacheEntry *uncached)
+{
+    GType gtype = G_OBJECT_TYPE(gobj);
+    GHashTable *cache;
+    PropertyCacheEntry *entry;
+    ID id_name;
+
+    if (!SYMBOL_P(prop_name))
+        StringValue(prop_name);
+    id_name = rb_check_id(&prop_name);
+    if (!id_name) {
+        uncached->pspec = property_find(gobj, StringValueCStr(prop_name));
+        uncached->id_child = rb_intern(g_param_spec_get_name(uncached->pspec));
+        uncached->setter = (RValueToGValueFunc)
+            property_lookup_converter(type_to_prop_setter_table,
+                                      uncached->pspec);
+        uncached->getter = (GValueToRValueFunc)
+            property_lookup_converter(type_to_prop_getter_table,
+                                      uncached->pspec);
+        return uncached;
+    }
+
+    cache = g_type_get_qdata(gtype, q_property_cache);
+    if (!cache) {
+        cache = g_hash_table_new_full(g_direct_hash, g_direct_equal,
+                                      NULL, property_cache_entry_free);
+        g_type_set_qdata(gtype, q_property_cache, cache);
+    }
+
+    entry = g_hash_table_lookup(cache, (gconstpointer)id_name);
+    if (entry && entry->serial == property_cache_serial)
+        return entry;
+
+    if (!entry) {
+        GParamSpec *pspec;
+
+        pspec = property_find(gobj, rb_id2name(id_name));
+        entry = g_new0(PropertyCacheEntry, 1);
+        entry->pspec = g_param_spec_ref(pspec);
+        entry->id_child = rb_intern(g_param_spec_get_name(pspec));
+        g_hash_table_insert(cache, (gpointer)id_name, entry);
+    }
+
+    entry->setter = (RValueToGValueFunc)
+        property_lookup_converter(type_to_prop_setter_table, entry->pspec);
+    entry->getter = (GValueToRValueFunc)
+        property_lookup_converter(type_to_prop_getter_table, entry->pspec);
+    entry->serial = property_cache_serial;
+
+    return entry;
+}
+
 void
 rbgobj_register_property_setter(GType gtype, const char *name, RValueToGValueFunc func)
 {
@@ -430,6 +539,7 @@ rbgobj_register_property_setter(GType gtype, const char *name, RValueToGValueFun
 
     rb_hash_aset(table, CSTR2RVAL(g_param_spec_get_name(pspec)),
                  Data_Wrap_Struct(rb_cData, NULL, NULL, func));
+    property_cache_serial++;
 
     g_type_class_unref(oclass);
 }
@@ -451,6 +561,7 @@ rbgobj_register_property_getter(GType gtype, const char *name, GValueToRValueFun
 
     rb_hash_aset(table, CSTR2RVAL(g_param_spec_get_name(pspec)),
                  Data_Wrap_Struct(rb_cData, NULL, NULL, func));
+    property_cache_serial++;
 
     g_type_class_unref(oclass);
 }
@@ -458,92 +569,48 @@ rbgobj_register_property_getter(GType gtype, const char *name, GValueToRValueFun
 static VALUE
 rg_set_property(VALUE self, VALUE prop_name, VALUE val)
 {
-    GParamSpec* pspec;
-    const char* name;
-
-    if (SYMBOL_P(prop_name))
-        name = rb_id2name(SYM2ID(prop_name));
-    else
-        name = StringValuePtr(prop_name);
-
-    pspec = g_object_class_find_property(G_OBJECT_GET_CLASS(RVAL2GOBJ(self)),
-                                         name);
-
-    if (!pspec)
-        rb_raise(eNoPropertyError, "No such property: %s", name);
-    else {
-        // FIXME: use rb_ensure to call g_value_unset()
-        RValueToGValueFunc setter = NULL;
-        GValue gval = G_VALUE_INIT;
+    GObject *gobj = RVAL2GOBJ(self);
+    PropertyCacheEntry *entry, uncached;
+    // FIXME: use rb_ensure to call g_value_unset()
+    GValue gval = G_VALUE_INIT;
 
-        g_value_init(&gval, G_PARAM_SPEC_VALUE_TYPE(pspec));
+    entry = property_cache_lookup(gobj, prop_name, &uncached);
 
-        {
-            VALUE table = rb_hash_aref(type_to_prop_setter_table,
-                                       INT2FIX(pspec->owner_type));
-            if (!NIL_P(table)){
-                VALUE obj = rb_hash_aref(table, CSTR2RVAL(g_param_spec_get_name(pspec)));
-                if (!NIL_P(obj))
-                    Data_Get_Struct(obj, void, setter);
-            }
-        }
-        if (setter) {
-            setter(val, &gval);
-        } else {
-            rbgobj_rvalue_to_gvalue(val, &gval);
-        }
+    g_value_init(&gval, G_PARAM_SPEC_VALUE_TYPE(entry->pspec));
+    if (entry->setter) {
+        entry->setter(val, &gval);
+    } else {
+        rbgobj_rvalue_to_gvalue(val, &gval);
+    }
 
-        g_object_set_property(RVAL2GOBJ(self), name, &gval);
-        g_value_unset(&gval);
+    g_object_set_property(gobj, g_param_spec_get_name(entry->pspec), &gval);
+    g_value_unset(&gval);
 
-        G_CHILD_SET(self, rb_intern(name), val);
+    G_CHILD_SET(self, entry->id_child, val);
 
-        return self;
-    }
+    return self;
 }
 
 static VALUE
 rg_get_property(VALUE self, VALUE prop_name)
 {
-    GParamSpec* pspec;
-    const char* name;
-
-    if (SYMBOL_P(prop_name))
-        name = rb_id2name(SYM2ID(prop_name));
-    else
-        name = StringValuePtr(prop_name);
-
-    pspec = g_object_class_find_property(G_OBJECT_GET_CLASS(RVAL2GOBJ(self)),
-                                         name);
-
-    if (!pspec)
-        rb_raise(eNoPropertyError, "No such property: %s", name);
-    else {
-        // FIXME: use rb_ensure to call g_value_unset()
-        GValueToRValueFunc getter = NULL;
-        GValue gval = G_VALUE_INIT;
-        VALUE ret;
+    GObject *gobj = RVAL2GOBJ(self);
+    PropertyCacheEntry *entry, uncached;
+    // FIXME: use rb_ensure to call g_value_unset()
+    GValue gval = G_VALUE_INIT;
+    VALUE ret;
 
-        {
-            VALUE table = rb_hash_aref(type_to_prop_getter_table,
-                                       INT2FIX(pspec->owner_type));
-            if (!NIL_P(table)){
-                VALUE obj = rb_hash_aref(table, CSTR2RVAL(g_param_spec_get_name(pspec)));
-                if (!NIL_P(obj))
-                    Data_Get_Struct(obj, void, getter);
-            }
-        }
+    entry = property_cache_lookup(gobj, prop_name, &uncached);
 
-        g_value_init(&gval, G_PARAM_SPEC_VALUE_TYPE(pspec));
-        g_object_get_property(RVAL2GOBJ(self), name, &gval);
+    g_value_init(&gval, G_PARAM_SPEC_VALUE_TYPE(entry->pspec));
+    g_object_get_property(gobj, g_param_spec_get_name(entry->pspec), &gval);
 
-        ret = getter ? getter(&gval) : GVAL2RVAL(&gval);
-        g_value_unset(&gval);
+    ret = entry->getter ? entry->getter(&gval) : GVAL2RVAL(&gval);
+    g_value_unset(&gval);
 
-        G_CHILD_SET(self, rb_intern(name), ret);
+    G_CHILD_SET(self, entry->id_child, ret);
 
-        return ret;
-    }
+    return ret;
 }
 
 static VALUE rg_thaw_notify(VALUE self);
@@ -572,6 +639,53 @@ rg_thaw_notify(VALUE self)
     return self;
 }
 
+static int
+set_properties_i(VALUE prop_name, VALUE val, VALUE self)
+{
+    rg_set_property(self, prop_name, val);
+    return ST_CONTINUE;
+}
+
+static VALUE
+set_properties_body(VALUE rb_args)
+{
+    VALUE self = RARRAY_PTR(rb_args)[0];
+    VALUE properties = RARRAY_PTR(rb_args)[1];
+
+    rb_hash_foreach(properties, set_properties_i, self);
+    return self;
+}
+
+static VALUE
+rg_set_properties(VALUE self, VALUE properties)
+{
+    VALUE rb_properties;
+
+    rb_properties = rbg_check_hash_type(properties);
+    if (NIL_P(rb_properties)) {
+        rb_raise(rb_eArgError,
+                 "properties must be a Hash: %s",
+                 RBG_INSPECT(properties));
+    }
+
+    g_object_freeze_notify(RVAL2GOBJ(self));
+    return rb_ensure(set_properties_body, rb_assoc_new(self, rb_properties),
+                     rg_thaw_notify, self);
+}
+
+static VALUE
+rg_get_properties(int argc, VALUE *argv, VALUE self)
+{
+    VALUE ary;
+    int i;
+
+    ary = rb_ary_new2(argc);
+    for (i = 0; i < argc; i++) {
+        rb_ary_push(ary, rg_get_property(self, argv[i]));
+    }
+    return ary;
+}
+
 static VALUE
 rg_destroyed_p(VALUE self)
 {
@@ -822,6 +936,7 @@ Init_gobject_gobject(void)
 #endif
 
     RUBY_GOBJECT_OBJ_KEY = g_quark_from_static_string("__ruby_gobject_object__");
+    q_property_cache = g_quark_from_static_string("__ruby_gobject_property_cache__");
 
     rb_define_alloc_func(RG_TARGET_NAMESPACE, (VALUE(*)_((VALUE)))gobj_s_allocate);
     RG_DEF_SMETHOD_BANG(new, -1);
@@ -834,6 +949,8 @@ Init_gobject_gobject(void)
 
     RG_DEF_METHOD(set_property, 2);
     RG_DEF_METHOD(get_property, 1);
+    RG_DEF_METHOD(set_properties, 1);
+    RG_DEF_METHOD(get_properties, -1);
     RG_DEF_METHOD(freeze_notify, 0);
     rb_undef_method(RG_TARGET_NAMESPACE, "notify");
     RG_DEF_METHOD(notify, 1);
@@ -34,6 +34,9 @@ static ID id_superclass;
 static ID id_lock;
 static ID id_unlock;
 static GHashTable *gtype_to_cinfo;
+/* Class infos that are completely initialized. Lookups that hit this
+ * table don't need to take lookup_class_mutex. */
+static GHashTable *gtype_to_cinfo_published;
 static VALUE klass_to_cinfo;
 
 static GHashTable* dynamic_gtype_list;
@@ -267,6 +270,12 @@ rbgobj_lookup_class_by_gtype_full(GType gtype, VALUE parent,
                                   gboolean create_class)
 {
     RGObjClassByGtypeData data;
+    const RGObjClassInfo *cinfo;
+
+    cinfo = g_hash_table_lookup(gtype_to_cinfo_published,
+                                GUINT_TO_POINTER(gtype));
+    if (cinfo)
+        return cinfo;
 
     data.gtype = gtype;
     data.parent = parent;
@@ -274,10 +283,14 @@ rbgobj_lookup_class_by_gtype_full(GType gtype, VALUE parent,
 
     if (create_class) {
         rb_funcall(lookup_class_mutex, id_lock, 0);
-        return (RGObjClassInfo *)rb_ensure(rbgobj_lookup_class_by_gtype_body,
-                                           (VALUE)&data,
-                                           rbgobj_lookup_class_by_gtype_ensure,
-                                           (VALUE)&data);
+        cinfo = (RGObjClassInfo *)rb_ensure(rbgobj_lookup_class_by_gtype_body,
+                                            (VALUE)&data,
+                                            rbgobj_lookup_class_by_gtype_ensure,
+                                            (VALUE)&data);
+        if (cinfo)
+            g_hash_table_insert(gtype_to_cinfo_published,
+                                GUINT_TO_POINTER(gtype), (gpointer)cinfo);
+        return cinfo;
     } else {
         return rbgobj_lookup_class_by_gtype_without_lock(gtype, parent,
                                                          create_class);
@@ -377,8 +390,11 @@ rbgobj_register_class(VALUE klass,
     if (klass2gtype)
         rb_hash_aset(klass_to_cinfo, cinfo->klass, c);
 
-    if (gtype2klass)
+    if (gtype2klass) {
         g_hash_table_insert(gtype_to_cinfo, GUINT_TO_POINTER(gtype), cinfo);
+        g_hash_table_insert(gtype_to_cinfo_published,
+                            GUINT_TO_POINTER(gtype), cinfo);
+    }
 }
 
 #define _register_fundamental_klass_to_gtype(klass, gtype) \
@@ -394,6 +410,7 @@ init_typemap(void)
     id_superclass = rb_intern("superclass");
 
     gtype_to_cinfo = g_hash_table_new(g_direct_hash, g_direct_equal);
+    gtype_to_cinfo_published = g_hash_table_new(g_direct_hash, g_direct_equal);
     rb_global_variable(&klass_to_cinfo);
     klass_to_cinfo = rb_hash_new();
 
@@ -311,7 +311,7 @@ rbgobj_define_property_accessors(VALUE klass)
         if (pspec->flags & G_PARAM_READABLE){
             g_string_append_printf(
                 source, 
-                "def %s%s; get_property('%s'); end\n",
+                "def %s%s; get_property(:\"%s\"); end\n",
                 prop_name,
                 (G_PARAM_SPEC_VALUE_TYPE(pspec) == G_TYPE_BOOLEAN) ? "?" : "",
                 pspec->name);
@@ -319,14 +319,14 @@ rbgobj_define_property_accessors(VALUE klass)
 
         if (IS_FLAG(pspec->flags, G_PARAM_WRITABLE) && !IS_FLAG(pspec->flags, G_PARAM_CONSTRUCT_ONLY)){
             g_string_append_printf(source,
-                "def set_%s(val); set_property('%s', val); end\n",
+                "def set_%s(val); set_property(:\"%s\", val); end\n",
                 prop_name, pspec->name);
 #ifdef HAVE_NODE_ATTRASGN
             g_string_append_printf(source, "alias %s= set_%s\n",
                                    prop_name, prop_name);
 #else
             g_string_append_printf(source,
-                "def %s=(val); set_property('%s', val); val; end\n",
+                "def %s=(val); set_property(:\"%s\", val); val; end\n",
                 prop_name, pspec->name);
 #endif
         }
@@ -123,6 +123,7 @@ typedef enum
     RBGOBJ_ABSTRACT_BUT_CREATABLE = 1 << 0, /* deprecated */
     RBGOBJ_BOXED_NOT_COPY         = 1 << 1,
     RBGOBJ_DEFINED_BY_RUBY        = 1 << 2,
+    RBGOBJ_BOXED_BORROW           = 1 << 3,
 } RGObjClassFlag;
 
 typedef void (*RGMarkFunc)(gpointer object);
@@ -234,11 +235,13 @@ extern void rbgobj_register_property_getter(GType gtype, const char* prop_name,
 extern VALUE rbgobj_boxed_create(VALUE klass); /* deprecated */
 extern gpointer rbgobj_boxed_get(VALUE obj, GType gtype);
 extern gpointer rbgobj_boxed_get_default(VALUE obj, GType gtype);
+extern gpointer rbgobj_boxed_peek(VALUE obj);
 extern VALUE rbgobj_make_boxed(gpointer data, GType gtype);
 extern VALUE rbgobj_make_boxed_raw(gpointer p, GType gtype,
                                    VALUE klass, gint flags);
 extern VALUE rbgobj_make_boxed_default(gpointer data, GType gtype);
 extern void rbgobj_boxed_not_copy_obj(GType gtype);
+extern void rbgobj_boxed_borrow_in_callbacks(GType gtype, gboolean borrow);
 extern void rbgobj_boxed_unown(VALUE boxed);
 
 /* rbgobj_enums.c */
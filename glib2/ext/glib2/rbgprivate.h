@@ -54,8 +54,19 @@ typedef struct {
     gpointer boxed;
     gboolean own;
     GType type;
+    gboolean borrowed;
 } boxed_holder;
 
+/* Boxed values converted from signal arguments while converting is
+ * TRUE are wrapped without copying when their class borrows in
+ * callbacks; the wrappers are invalidated when the scope is popped. */
+typedef struct _RGBoxedBorrowScope RGBoxedBorrowScope;
+struct _RGBoxedBorrowScope {
+    VALUE wrappers;
+    gboolean converting;
+    RGBoxedBorrowScope *previous;
+};
+
 #ifdef HAVE_RB_THREAD_BLOCKING_REGION
 G_GNUC_INTERNAL extern GStaticPrivate rg_polling_key;
 #endif
@@ -116,7 +127,15 @@ extern gboolean rbgobj_convert_unref(GType type, gpointer instance);
 
 #define RubyGObjectHookModule "RubyGObjectHook__"
 
+G_GNUC_INTERNAL void rbgobj_boxed_borrow_scope_push(RGBoxedBorrowScope *scope);
+G_GNUC_INTERNAL void rbgobj_boxed_borrow_scope_pop(RGBoxedBorrowScope *scope);
+
 G_GNUC_INTERNAL VALUE rg_enum_resolve_value(VALUE klass, VALUE nick);
+G_GNUC_INTERNAL void rg_enum_table_init(VALUE klass);
+G_GNUC_INTERNAL VALUE rg_enum_table_lookup(VALUE klass, VALUE number);
+G_GNUC_INTERNAL gboolean rg_enum_table_add(VALUE klass, VALUE number, VALUE instance, long max_size);
+G_GNUC_INTERNAL void rg_enum_table_add_name(VALUE klass, const gchar *nick, VALUE instance);
+G_GNUC_INTERNAL VALUE rg_enum_table_lookup_name(VALUE klass, VALUE name);
 G_GNUC_INTERNAL void rg_enum_add_constants(VALUE mod, GType enum_type, const gchar *strip_prefix);
 G_GNUC_INTERNAL void rg_flags_add_constants(VALUE mod, GType flags_type, const gchar *strip_prefix);
 G_GNUC_INTERNAL char *rg_obj_constant_lookup(const char *name);
@@ -95,6 +95,27 @@ extern VALUE rbgutil_invoke_callback(VALUE (*func)(VALUE), VALUE arg);
 extern void rbgutil_start_callback_dispatch_thread(void);
 extern void rbgutil_stop_callback_dispatch_thread(void);
 
+typedef enum {
+    RBGUTIL_CALLBACK_OVERFLOW_DROP,
+    RBGUTIL_CALLBACK_OVERFLOW_COALESCE,
+    RBGUTIL_CALLBACK_OVERFLOW_BLOCK
+} RBGUtilCallbackOverflowPolicy;
+
+typedef struct _RBGUtilAsyncCallback RBGUtilAsyncCallback;
+extern RBGUtilAsyncCallback *rbgutil_async_callback_new(VALUE (*func)(VALUE),
+                                                        GDestroyNotify destroy,
+                                                        guint capacity,
+                                                        RBGUtilCallbackOverflowPolicy policy);
+extern void rbgutil_async_callback_set_finalize_func(RBGUtilAsyncCallback *callback,
+                                                     GDestroyNotify finalize,
+                                                     gpointer data);
+extern void rbgutil_async_callback_invoke(RBGUtilAsyncCallback *callback,
+                                          gpointer data);
+extern guint rbgutil_async_callback_get_n_dropped(RBGUtilAsyncCallback *callback);
+extern RBGUtilAsyncCallback *rbgutil_async_callback_ref(RBGUtilAsyncCallback *callback);
+extern void rbgutil_async_callback_unref(RBGUtilAsyncCallback *callback);
+extern void rbgutil_async_callback_free(RBGUtilAsyncCallback *callback);
+
 extern VALUE rbgutil_string_set_utf8_encoding(VALUE string);
 extern gboolean rbgutil_key_equal(VALUE rb_string, const char *key);
 
@@ -58,22 +58,70 @@ rbgutil_protect(VALUE (*func) (VALUE), VALUE data)
 
 #ifdef HAVE_NATIVETHREAD
 
+typedef struct _CallbackWaiter {
+    GMutex *mutex;
+    GCond *cond;
+} CallbackWaiter;
+
 typedef struct _CallbackRequest {
     VALUE (*function)(VALUE);
     VALUE argument;
     VALUE result;
-    GMutex *done_mutex;
-    GCond *done_cond;
+    CallbackWaiter *waiter;
+    gboolean done;
 } CallbackRequest;
 
 static GMutex *callback_dispatch_thread_mutex = NULL;
 static GAsyncQueue *callback_request_queue = NULL;
 static ID id_callback_dispatch_thread;
 static gint callback_pipe_fds[2] = {-1, -1};
+/* TRUE while a ready message is in the pipe and not read yet. Requests
+ * queued in the meantime are picked up by the same wakeup. */
+static volatile gint callback_pipe_pending = FALSE;
+static GStaticPrivate callback_waiter_key = G_STATIC_PRIVATE_INIT;
+static CallbackRequest callback_request_stop;
+
+/* Requests are processed by a pool of reusable Ruby threads fed from
+ * callback_worker_queue. The pool grows when all workers are busy and
+ * shrinks to CALLBACK_WORKER_MAX_IDLE idle workers. These are only
+ * touched with the GVL held. */
+#define CALLBACK_WORKER_MAX_IDLE 4
+static VALUE callback_worker_queue = Qnil;
+static gint callback_n_idle_workers = 0;
+static gboolean callback_workers_stopping = FALSE;
+static ID id_push;
+static ID id_pop;
 
 #define CALLBACK_PIPE_READY_MESSAGE "R"
 #define CALLBACK_PIPE_READY_MESSAGE_SIZE 1
 
+static void
+callback_waiter_free(gpointer data)
+{
+    CallbackWaiter *waiter = data;
+
+    g_cond_free(waiter->cond);
+    g_mutex_free(waiter->mutex);
+    g_free(waiter);
+}
+
+static CallbackWaiter *
+callback_waiter_get(void)
+{
+    CallbackWaiter *waiter;
+
+    waiter = g_static_private_get(&callback_waiter_key);
+    if (!waiter) {
+        waiter = g_new(CallbackWaiter, 1);
+        waiter->mutex = g_mutex_new();
+        waiter->cond = g_cond_new();
+        g_static_private_set(&callback_waiter_key, waiter,
+                             callback_waiter_free);
+    }
+
+    return waiter;
+}
+
 static VALUE
 exec_callback(VALUE data)
 {
@@ -81,21 +129,74 @@ exec_callback(VALUE data)
     return request->function(request->argument);
 }
 
-static VALUE
+static void
 process_request(CallbackRequest *request)
 {
-    g_mutex_lock(request->done_mutex);
-    request->result = rbgutil_protect(exec_callback, (VALUE)request);
-    g_cond_signal(request->done_cond);
-    g_mutex_unlock(request->done_mutex);
+    CallbackWaiter *waiter = request->waiter;
+    VALUE result;
+
+    result = rbgutil_protect(exec_callback, (VALUE)request);
+    if (!waiter)
+        return;
+
+    g_mutex_lock(waiter->mutex);
+    request->result = result;
+    request->done = TRUE;
+    g_cond_signal(waiter->cond);
+    g_mutex_unlock(waiter->mutex);
+}
+
+static VALUE
+worker_mainloop(void)
+{
+    for (;;) {
+        VALUE rb_request;
+        CallbackRequest *request;
+
+        rb_request = rb_funcall(callback_worker_queue, id_pop, 0);
+        if (NIL_P(rb_request))
+            break;
+
+        Data_Get_Struct(rb_request, CallbackRequest, request);
+        process_request(request);
+
+        if (callback_workers_stopping ||
+            callback_n_idle_workers >= CALLBACK_WORKER_MAX_IDLE)
+            break;
+        callback_n_idle_workers++;
+    }
 
     return Qnil;
 }
 
+static void
+dispatch_request(CallbackRequest *request)
+{
+    if (callback_n_idle_workers > 0) {
+        callback_n_idle_workers--;
+    } else {
+        rb_thread_create(worker_mainloop, NULL);
+    }
+    rb_funcall(callback_worker_queue, id_push, 1,
+               Data_Wrap_Struct(rb_cData, NULL, NULL, request));
+}
+
+static void
+stop_workers(void)
+{
+    callback_workers_stopping = TRUE;
+    for (; callback_n_idle_workers > 0; callback_n_idle_workers--) {
+        rb_funcall(callback_worker_queue, id_push, 1, Qnil);
+    }
+}
+
 static VALUE
 mainloop(void)
 {
-    for (;;) {
+    gboolean running = TRUE;
+
+    callback_workers_stopping = FALSE;
+    while (running) {
         CallbackRequest *request;
         gchar ready_message_buffer[CALLBACK_PIPE_READY_MESSAGE_SIZE];
 
@@ -109,13 +210,19 @@ mainloop(void)
             g_error("failed to read valid callback dispatcher message");
             continue;
         }
-        request = g_async_queue_pop(callback_request_queue);
-        if (!request)
-            break;
-
-        rb_thread_create(process_request, request);
+        g_atomic_int_set(&callback_pipe_pending, FALSE);
+
+        while ((request = g_async_queue_try_pop(callback_request_queue))) {
+            if (request == &callback_request_stop) {
+                running = FALSE;
+                break;
+            }
+            dispatch_request(request);
+        }
     }
 
+    stop_workers();
+
     close(callback_pipe_fds[0]);
     callback_pipe_fds[0] = -1;
     close(callback_pipe_fds[1]);
@@ -130,6 +237,10 @@ queue_callback_request(CallbackRequest *request)
     ssize_t written;
 
     g_async_queue_push(callback_request_queue, request);
+    if (!g_atomic_int_compare_and_exchange(&callback_pipe_pending,
+                                           FALSE, TRUE))
+        return;
+
     written = write(callback_pipe_fds[1],
                     CALLBACK_PIPE_READY_MESSAGE,
                     CALLBACK_PIPE_READY_MESSAGE_SIZE);
@@ -145,6 +256,7 @@ static VALUE
 invoke_callback_in_ruby_thread(VALUE (*func)(VALUE), VALUE arg)
 {
     CallbackRequest request;
+    CallbackWaiter *waiter;
 
     g_mutex_lock(callback_dispatch_thread_mutex);
     if (callback_pipe_fds[0] == -1) {
@@ -155,24 +267,192 @@ invoke_callback_in_ruby_thread(VALUE (*func)(VALUE), VALUE arg)
         return Qnil;
     }
 
+    waiter = callback_waiter_get();
     request.function = func;
     request.argument = arg;
     request.result = Qnil;
-    request.done_mutex = g_mutex_new();
-    request.done_cond = g_cond_new();
+    request.waiter = waiter;
+    request.done = FALSE;
 
-    g_mutex_lock(request.done_mutex);
+    g_mutex_lock(waiter->mutex);
     queue_callback_request(&request);
     g_mutex_unlock(callback_dispatch_thread_mutex);
 
-    g_cond_wait(request.done_cond, request.done_mutex);
-    g_mutex_unlock(request.done_mutex);
+    while (!request.done)
+        g_cond_wait(waiter->cond, waiter->mutex);
+    g_mutex_unlock(waiter->mutex);
 
-    g_cond_free(request.done_cond);
-    g_mutex_free(request.done_mutex);
+    return request.result;
+}
 
+/*
+ * Asynchronous callbacks: native threads store their data in a bounded
+ * ring and return immediately. The first item queued into an empty ring
+ * schedules one drain request on the dispatcher, which then runs the
+ * callback for the queued items in batches on a Ruby thread. The ring
+ * lock is never held while Ruby code runs.
+ *
+ * The callback is reference counted: the owner, each running
+ * rbgutil_async_callback_invoke() and a scheduled drain hold a
+ * reference. The last one to go releases the callback on a Ruby
+ * thread, so the finalize function may use Ruby API.
+ */
+#define ASYNC_CALLBACK_BATCH_SIZE 64
+
+struct _RBGUtilAsyncCallback {
+    VALUE (*func)(VALUE);
+    GDestroyNotify destroy;
+    GDestroyNotify finalize;
+    gpointer finalize_data;
+    volatile gint ref_count;
+    RBGUtilCallbackOverflowPolicy policy;
+    GMutex *mutex;
+    GCond *space_cond;
+    gpointer *items;
+    guint capacity;
+    guint head;
+    guint n_items;
+    guint n_dropped;
+    gboolean scheduled;
+    gboolean freed;
+    CallbackRequest drain_request;
+    CallbackRequest release_request;
+};
 
-    return request.result;
+static void
+async_callback_destroy_item(RBGUtilAsyncCallback *callback, gpointer data)
+{
+    if (callback->destroy)
+        callback->destroy(data);
+}
+
+static VALUE
+async_callback_release(VALUE data)
+{
+    RBGUtilAsyncCallback *callback = (RBGUtilAsyncCallback *)data;
+
+    if (callback->finalize)
+        callback->finalize(callback->finalize_data);
+    g_cond_free(callback->space_cond);
+    g_mutex_free(callback->mutex);
+    g_free(callback->items);
+    g_free(callback);
+
+    return Qnil;
+}
+
+static void
+async_callback_queue_request(CallbackRequest *request)
+{
+    g_mutex_lock(callback_dispatch_thread_mutex);
+    if (callback_pipe_fds[0] == -1) {
+        g_error("Please call rbgutil_start_callback_dispatch_thread() "
+                "to dispatch a callback from non-ruby thread before "
+                "callbacks are requested from non-ruby thread.");
+        g_mutex_unlock(callback_dispatch_thread_mutex);
+        return;
+    }
+    queue_callback_request(request);
+    g_mutex_unlock(callback_dispatch_thread_mutex);
+}
+
+static void
+async_callback_unref(RBGUtilAsyncCallback *callback)
+{
+    if (!g_atomic_int_dec_and_test(&(callback->ref_count)))
+        return;
+
+    if (ruby_native_thread_p()) {
+        async_callback_release((VALUE)callback);
+    } else {
+        async_callback_queue_request(&(callback->release_request));
+    }
+}
+
+static VALUE
+async_callback_drain(VALUE data)
+{
+    RBGUtilAsyncCallback *callback = (RBGUtilAsyncCallback *)data;
+    gpointer batch[ASYNC_CALLBACK_BATCH_SIZE];
+
+    for (;;) {
+        guint i, n;
+
+        g_mutex_lock(callback->mutex);
+        n = MIN(callback->n_items, ASYNC_CALLBACK_BATCH_SIZE);
+        for (i = 0; i < n; i++) {
+            batch[i] = callback->items[callback->head];
+            callback->head = (callback->head + 1) % callback->capacity;
+        }
+        callback->n_items -= n;
+        if (n == 0) {
+            callback->scheduled = FALSE;
+            g_mutex_unlock(callback->mutex);
+            break;
+        }
+        g_cond_broadcast(callback->space_cond);
+        g_mutex_unlock(callback->mutex);
+
+        for (i = 0; i < n; i++) {
+            rbgutil_protect(callback->func, (VALUE)batch[i]);
+            async_callback_destroy_item(callback, batch[i]);
+        }
+    }
+
+    /* The reference taken when the drain was scheduled. */
+    async_callback_unref(callback);
+
+    return Qnil;
+}
+
+static void
+async_callback_enqueue(RBGUtilAsyncCallback *callback, gpointer data)
+{
+    gpointer replaced = NULL;
+    gboolean need_schedule = FALSE;
+
+    g_mutex_lock(callback->mutex);
+    while (!callback->freed && callback->n_items == callback->capacity) {
+        if (callback->policy == RBGUTIL_CALLBACK_OVERFLOW_DROP) {
+            callback->n_dropped++;
+            replaced = data;
+            data = NULL;
+            break;
+        } else if (callback->policy == RBGUTIL_CALLBACK_OVERFLOW_COALESCE) {
+            guint last;
+
+            last = (callback->head + callback->n_items - 1) % callback->capacity;
+            callback->n_dropped++;
+            replaced = callback->items[last];
+            callback->items[last] = data;
+            data = NULL;
+            break;
+        } else {
+            g_cond_wait(callback->space_cond, callback->mutex);
+        }
+    }
+    if (data && callback->freed) {
+        replaced = data;
+        data = NULL;
+    }
+    if (data) {
+        guint tail;
+
+        tail = (callback->head + callback->n_items) % callback->capacity;
+        callback->items[tail] = data;
+        callback->n_items++;
+        if (!callback->scheduled) {
+            callback->scheduled = TRUE;
+            g_atomic_int_inc(&(callback->ref_count));
+            need_schedule = TRUE;
+        }
+    }
+    g_mutex_unlock(callback->mutex);
+
+    if (replaced)
+        async_callback_destroy_item(callback, replaced);
+    if (need_schedule)
+        async_callback_queue_request(&(callback->drain_request));
 }
 
 #ifdef HAVE_RB_THREAD_CALL_WITH_GVL
@@ -217,6 +497,157 @@ rbgutil_invoke_callback(VALUE (*func)(VALUE), VALUE arg)
 
 /**********************************************************************/
 
+#ifndef HAVE_NATIVETHREAD
+struct _RBGUtilAsyncCallback {
+    VALUE (*func)(VALUE);
+    GDestroyNotify destroy;
+    GDestroyNotify finalize;
+    gpointer finalize_data;
+    gint ref_count;
+    guint n_dropped;
+    gboolean freed;
+};
+
+static void
+async_callback_unref(RBGUtilAsyncCallback *callback)
+{
+    if (--callback->ref_count > 0)
+        return;
+
+    if (callback->finalize)
+        callback->finalize(callback->finalize_data);
+    g_free(callback);
+}
+#endif
+
+/*
+ * Creates a callback that doesn't block the calling native thread.
+ * func is called with each data passed to rbgutil_async_callback_invoke()
+ * and destroy, if not NULL, is called with it afterwards. At most
+ * capacity items are queued; policy decides what happens when the
+ * queue is full:
+ *
+ *   RBGUTIL_CALLBACK_OVERFLOW_DROP: the new data is dropped.
+ *   RBGUTIL_CALLBACK_OVERFLOW_COALESCE: the new data replaces the newest
+ *     queued data.
+ *   RBGUTIL_CALLBACK_OVERFLOW_BLOCK: the caller waits for free space.
+ *
+ * destroy may be called from a native thread for dropped data, so it
+ * must not use Ruby API.
+ */
+RBGUtilAsyncCallback *
+rbgutil_async_callback_new(VALUE (*func)(VALUE), GDestroyNotify destroy,
+                           guint capacity,
+                           RBGUtilCallbackOverflowPolicy policy)
+{
+    RBGUtilAsyncCallback *callback;
+
+    callback = g_new0(RBGUtilAsyncCallback, 1);
+    callback->func = func;
+    callback->destroy = destroy;
+    callback->ref_count = 1;
+#ifdef HAVE_NATIVETHREAD
+    callback->policy = policy;
+    callback->capacity = MAX(capacity, 1);
+    callback->items = g_new(gpointer, callback->capacity);
+    callback->mutex = g_mutex_new();
+    callback->space_cond = g_cond_new();
+    callback->drain_request.function = async_callback_drain;
+    callback->drain_request.argument = (VALUE)callback;
+    callback->drain_request.result = Qnil;
+    callback->drain_request.waiter = NULL;
+    callback->release_request.function = async_callback_release;
+    callback->release_request.argument = (VALUE)callback;
+    callback->release_request.result = Qnil;
+    callback->release_request.waiter = NULL;
+#endif
+
+    return callback;
+}
+
+/*
+ * Sets a function that is called with data once the callback is
+ * released. It is always called on a Ruby thread, so it may use Ruby
+ * API, e.g. to release the Ruby objects func refers to.
+ */
+void
+rbgutil_async_callback_set_finalize_func(RBGUtilAsyncCallback *callback,
+                                         GDestroyNotify finalize,
+                                         gpointer data)
+{
+    callback->finalize = finalize;
+    callback->finalize_data = data;
+}
+
+void
+rbgutil_async_callback_invoke(RBGUtilAsyncCallback *callback, gpointer data)
+{
+    rbgutil_async_callback_ref(callback);
+#ifdef HAVE_NATIVETHREAD
+    if (!ruby_native_thread_p()) {
+        async_callback_enqueue(callback, data);
+        async_callback_unref(callback);
+        return;
+    }
+#endif
+    if (!callback->freed)
+        rbgutil_invoke_callback(callback->func, (VALUE)data);
+    if (callback->destroy)
+        callback->destroy(data);
+    async_callback_unref(callback);
+}
+
+guint
+rbgutil_async_callback_get_n_dropped(RBGUtilAsyncCallback *callback)
+{
+    return callback->n_dropped;
+}
+
+/*
+ * Takes a reference for a producer that may still invoke callback
+ * after its owner called rbgutil_async_callback_free(). Release it
+ * with rbgutil_async_callback_unref().
+ */
+RBGUtilAsyncCallback *
+rbgutil_async_callback_ref(RBGUtilAsyncCallback *callback)
+{
+#ifdef HAVE_NATIVETHREAD
+    g_atomic_int_inc(&(callback->ref_count));
+#else
+    callback->ref_count++;
+#endif
+    return callback;
+}
+
+void
+rbgutil_async_callback_unref(RBGUtilAsyncCallback *callback)
+{
+    async_callback_unref(callback);
+}
+
+/*
+ * Drops the owner's reference. Data that is already queued is still
+ * processed, but data passed to rbgutil_async_callback_invoke() from
+ * now on is only destroyed. Producers blocked on a full queue are woken
+ * up. The callback is released once the queue is drained and no
+ * rbgutil_async_callback_invoke() is running anymore.
+ */
+void
+rbgutil_async_callback_free(RBGUtilAsyncCallback *callback)
+{
+#ifdef HAVE_NATIVETHREAD
+    g_mutex_lock(callback->mutex);
+    callback->freed = TRUE;
+    g_cond_broadcast(callback->space_cond);
+    g_mutex_unlock(callback->mutex);
+#else
+    callback->freed = TRUE;
+#endif
+    async_callback_unref(callback);
+}
+
+/**********************************************************************/
+
 void
 rbgutil_start_callback_dispatch_thread(void)
 {
@@ -246,7 +677,7 @@ rbgutil_stop_callback_dispatch_thread(void)
     g_mutex_lock(callback_dispatch_thread_mutex);
     callback_dispatch_thread = rb_ivar_get(mGLib, id_callback_dispatch_thread);
     if (!NIL_P(callback_dispatch_thread)) {
-        queue_callback_request(NULL);
+        queue_callback_request(&callback_request_stop);
         rb_ivar_set(mGLib, id_callback_dispatch_thread, Qnil);
     }
     g_mutex_unlock(callback_dispatch_thread_mutex);
@@ -270,5 +701,13 @@ Init_gutil_callback(void)
 
     callback_request_queue = g_async_queue_new();
     callback_dispatch_thread_mutex = g_mutex_new();
+
+    id_push = rb_intern("push");
+    id_pop = rb_intern("pop");
+    rb_require("thread");
+    rb_global_variable(&callback_worker_queue);
+    callback_worker_queue = rb_funcall(rb_const_get(rb_cObject,
+                                                    rb_intern("Queue")),
+                                       rb_intern("new"), 0);
 #endif
 }
@@ -0,0 +1,72 @@
+# -*- coding: utf-8 -*-
+#
+# Copyright (C) 2013  Ruby-GNOME2 Project Team
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+class TestGLibBoxed < Test::Unit::TestCase
+  class PollFDEmitter < GLib::Object
+    type_register("TestGLibBoxedPollFDEmitter")
+
+    signal_new("polled",
+               GLib::Signal::RUN_FIRST,
+               nil,
+               GLib::Type["void"],
+               GLib::PollFD)
+
+    def signal_do_polled(poll_fd)
+    end
+  end
+
+  def setup
+    @emitter = PollFDEmitter.new
+    @poll_fd = GLib::PollFD.new(0, GLib::IOChannel::IN, 0)
+  end
+
+  def teardown
+    GLib::PollFD.borrow_in_callbacks = false
+  end
+
+  def test_copy_by_default
+    received = nil
+    @emitter.signal_connect("polled") do |_, poll_fd|
+      received = poll_fd
+    end
+    @emitter.signal_emit("polled", @poll_fd)
+    assert_false(GLib::PollFD.borrow_in_callbacks?)
+    assert_false(received.borrowed?)
+    assert_equal(0, received.fd)
+  end
+
+  def test_borrow_in_callbacks
+    GLib::PollFD.borrow_in_callbacks = true
+    received = nil
+    kept = nil
+    fd = nil
+    @emitter.signal_connect("polled") do |_, poll_fd|
+      received = poll_fd
+      fd = poll_fd.fd
+      kept = poll_fd.dup
+    end
+    @emitter.signal_emit("polled", @poll_fd)
+    assert_true(received.borrowed?)
+    assert_equal(0, fd)
+    assert_false(kept.borrowed?)
+    assert_equal(0, kept.fd)
+    assert_raise(RuntimeError) do
+      received.fd
+    end
+  end
+end
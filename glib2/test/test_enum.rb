@@ -74,6 +74,23 @@ class TestEnum < Test::Unit::TestCase
                  GLib::KeyFile::KEEP_COMMENTS | [:keep_translations])
   end
 
+  def test_enum_interned
+    assert_same(GLib::NormalizeMode::NFD,
+                GLib::NormalizeMode.values.find {|mode| mode == :nfd})
+  end
+
+  def test_flags_interned
+    assert_same(GLib::KeyFile::KEEP_COMMENTS | GLib::KeyFile::KEEP_TRANSLATIONS,
+                GLib::KeyFile::KEEP_COMMENTS | GLib::KeyFile::KEEP_TRANSLATIONS)
+  end
+
+  def test_interned_frozen
+    assert_equal([true, true],
+                 [GLib::NormalizeMode::NFD.frozen?,
+                  (GLib::KeyFile::KEEP_COMMENTS |
+                   GLib::KeyFile::KEEP_TRANSLATIONS).frozen?])
+  end
+
   private
   def assert_key_file_load(flags, convenience_flags)
     data = <<-EOD
@@ -0,0 +1,99 @@
+# -*- coding: utf-8 -*-
+#
+# Copyright (C) 2013  Ruby-GNOME2 Project Team
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+class TestGLibObject < Test::Unit::TestCase
+  class Counter < GLib::Object
+    type_register("TestGLibObjectCounter")
+
+    install_property(GLib::Param::Int.new("count", "Count", "The count",
+                                          0, 100, 0,
+                                          GLib::Param::READABLE |
+                                          GLib::Param::WRITABLE))
+    install_property(GLib::Param::Int.new("step", "Step", "The step",
+                                          0, 100, 1,
+                                          GLib::Param::READABLE |
+                                          GLib::Param::WRITABLE))
+
+    attr_reader :notified_in_setter
+
+    def initialize
+      super
+      @count = 0
+      @step = 1
+      @n_notified = 0
+      @notified_in_setter = []
+      signal_connect("notify") do
+        @n_notified += 1
+      end
+    end
+
+    def n_notified
+      @n_notified
+    end
+
+    def count
+      @count
+    end
+
+    def count=(count)
+      @notified_in_setter << @n_notified
+      @count = count
+    end
+
+    def step
+      @step
+    end
+
+    def step=(step)
+      @notified_in_setter << @n_notified
+      @step = step
+    end
+  end
+
+  def setup
+    @counter = Counter.new
+  end
+
+  def test_set_properties_get_properties
+    @counter.set_properties(:count => 10, "step" => 2)
+    assert_equal([10, 2], @counter.get_properties(:count, "step"))
+  end
+
+  def test_set_properties_notify_after_thaw
+    @counter.set_properties(:count => 10, "count" => 20)
+    assert_equal([[0, 0], 1, 20],
+                 [@counter.notified_in_setter,
+                  @counter.n_notified,
+                  @counter.get_properties(:count)[0]])
+  end
+
+  def test_set_properties_thaw_on_error
+    assert_raise(TypeError) do
+      @counter.set_properties(:count => 10, :step => "not a number")
+    end
+    assert_equal(1, @counter.n_notified)
+    @counter.set_property(:step, 3)
+    assert_equal(2, @counter.n_notified)
+  end
+
+  def test_set_properties_not_hash
+    assert_raise(ArgumentError) do
+      @counter.set_properties([:count, 10])
+    end
+  end
+end
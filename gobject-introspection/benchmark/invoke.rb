@@ -0,0 +1,77 @@
+#!/usr/bin/env ruby
+#
+# Copyright (C) 2013  Ruby-GNOME2 Project Team
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+# Compares the Ruby closure based method definition used by
+# GObjectIntrospection::Loader before with the native invoker
+# based one on a trivial getter (Gio::Cancellable#cancelled?).
+#
+#   % ruby -I glib2/lib -I glib2/ext/glib2 \
+#       -I gobject-introspection/lib \
+#       -I gobject-introspection/ext/gobject-introspection \
+#       gobject-introspection/benchmark/invoke.rb [N_CALLS]
+
+require "benchmark"
+require "gobject-introspection"
+
+n_calls = Integer(ARGV[0] || 1_000_000)
+
+repository = GObjectIntrospection::Repository.default
+repository.require("Gio")
+object_info = repository.find("Gio", "Cancellable")
+info = object_info.methods.find do |method_info|
+  method_info.name == "is_cancelled"
+end
+
+sandbox = Module.new
+klass = GObjectIntrospection::Loader.define_class(object_info.gtype,
+                                                  "Cancellable",
+                                                  sandbox)
+
+klass.__send__(:define_method, "closure_cancelled?") do |*arguments, &block|
+  n_in_args = info.n_in_args
+  n_required_in_args = info.n_required_in_args
+  unless (n_required_in_args..n_in_args).cover?(arguments.size)
+    raise ArgumentError, "wrong number of arguments"
+  end
+  if block.nil? and info.require_callback?
+    Enumerator.new(self, "closure_cancelled?", *arguments)
+  else
+    info.invoke({
+                  :receiver => self,
+                  :arguments => arguments,
+                  :unlock_gvl => false,
+                },
+                &block)
+  end
+end
+GObjectIntrospection::Loader.define_method_invoker(info, klass,
+                                                   "cancelled?", false)
+
+cancellable = klass.new
+Benchmark.bmbm do |benchmark|
+  benchmark.report("closure") do
+    n_calls.times do
+      cancellable.closure_cancelled?
+    end
+  end
+  benchmark.report("invoker") do
+    n_calls.times do
+      cancellable.cancelled?
+    end
+  end
+end
@@ -0,0 +1,61 @@
+#!/usr/bin/env ruby
+#
+# Copyright (C) 2013  Ruby-GNOME2 Project Team
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+# Compares load time and RSS of a namespace loaded eagerly and lazily
+# by GObjectIntrospection::Loader. Each mode runs in a new process.
+#
+#   % ruby -I glib2/lib -I glib2/ext/glib2 \
+#       -I gobject-introspection/lib \
+#       -I gobject-introspection/ext/gobject-introspection \
+#       gobject-introspection/benchmark/load.rb [NAMESPACE] [VERSION]
+
+require "rbconfig"
+
+namespace = ARGV[0] || "Gtk"
+version = ARGV[1] || (namespace == "Gtk" ? "3.0" : nil)
+
+def rss_kb
+  File.read("/proc/self/status")[/^VmRSS:\s*(\d+)/, 1].to_i
+rescue SystemCallError
+  0
+end
+
+if ENV["GI_BENCHMARK_CHILD"]
+  lazy = (ENV["GI_BENCHMARK_CHILD"] == "lazy")
+  require "gobject-introspection"
+  base_module = Module.new
+  before_rss = rss_kb
+  start = Time.now
+  GObjectIntrospection::Loader.load(namespace, base_module,
+                                    :version => version,
+                                    :lazy => lazy)
+  elapsed = Time.now - start
+  printf("%-5s: %8.3fs %8dKiB\n",
+         ENV["GI_BENCHMARK_CHILD"], elapsed, rss_kb - before_rss)
+  exit!(true)
+end
+
+ruby = File.join(RbConfig::CONFIG["bindir"],
+                 RbConfig::CONFIG["ruby_install_name"])
+load_path_options = $LOAD_PATH.collect do |path|
+  ["-I", path]
+end.flatten
+["eager", "lazy"].each do |mode|
+  ENV["GI_BENCHMARK_CHILD"] = mode
+  system(ruby, *load_path_options, __FILE__, *ARGV)
+end
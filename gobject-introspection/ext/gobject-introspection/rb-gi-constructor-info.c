@@ -86,12 +86,14 @@ rg_invoke(VALUE self, VALUE rb_options)
 {
     GIFunctionInfo *info;
     GICallableInfo *callable_info;
+    RBGIInvokePlan *plan;
     VALUE receiver;
     GIArgument return_value;
     GITypeInfo return_value_info;
 
     info = SELF(self);
     callable_info = (GICallableInfo *)info;
+    plan = rb_gi_function_info_get_invoke_plan(self);
 
     rb_options = rbg_to_hash(rb_options);
     receiver = rb_hash_delete(rb_options, ID2SYM(rb_intern("receiver")));
@@ -104,7 +106,7 @@ rg_invoke(VALUE self, VALUE rb_options)
                  RBG_INSPECT(rb_options));
     }
     /* TODO: use rb_protect */
-    rb_gi_function_info_invoke_raw(info,
+    rb_gi_function_info_invoke_raw(plan,
                                    rb_options,
                                    &return_value);
 
@@ -38,6 +38,7 @@ static VALUE RG_TARGET_NAMESPACE;
 static VALUE rb_cGLibError;
 static const char *callbacks_key = "gi_callbacks";
 static GPtrArray *callback_finders;
+static ID id_invoke_plan;
 
 GType
 gi_function_info_get_type(void)
@@ -87,26 +88,33 @@ rg_vfunc(VALUE self)
     return GI_BASE_INFO2RVAL(g_function_info_get_vfunc(info));
 }
 
+struct RBGIInvokePlan_ {
+    GIFunctionInfo *info;
+    gboolean method_p;
+    gboolean gobject_based_p;
+    gboolean require_callback_p;
+    gint n_args;
+    gint n_in_args;
+    gint n_out_args;
+    gint n_rb_args;
+    GITypeTag return_type_tag;
+    RBGIArgMetadata *args_metadata;
+};
+
 static void
-allocate_arguments(GICallableInfo *info,
-                   GArray *in_args, GArray *out_args,
-                   GPtrArray *args_metadata)
+invoke_plan_allocate_arguments(RBGIInvokePlan *plan)
 {
-    gint i, n_args;
-    gint rb_arg_index = 0;
+    gint i;
 
-    n_args = g_callable_info_get_n_args(info);
-    for (i = 0; i < n_args; i++) {
-        GIArgument argument;
+    plan->args_metadata = ALLOC_N(RBGIArgMetadata, plan->n_args);
+    for (i = 0; i < plan->n_args; i++) {
         RBGIArgMetadata *metadata;
         GIArgInfo *arg_info;
         GIDirection direction;
 
-        memset(&argument, 0, sizeof(GIArgument));
-
-        metadata = ALLOC(RBGIArgMetadata);
+        metadata = &(plan->args_metadata[i]);
         arg_info = &(metadata->arg_info);
-        g_callable_info_load_arg(info, i, arg_info);
+        g_callable_info_load_arg((GICallableInfo *)(plan->info), i, arg_info);
         metadata->scope_type = g_arg_info_get_scope(arg_info);
         metadata->direction = g_arg_info_get_direction(arg_info);
         metadata->callback_p = (metadata->scope_type != GI_SCOPE_TYPE_INVALID);
@@ -122,31 +130,30 @@ allocate_arguments(GICallableInfo *info,
 
         direction = metadata->direction;
         if (direction == GI_DIRECTION_IN || direction == GI_DIRECTION_INOUT) {
-            metadata->in_arg_index = in_args->len;
-            g_array_append_val(in_args, argument);
-            metadata->rb_arg_index = rb_arg_index++;
+            metadata->in_arg_index = plan->n_in_args++;
+            metadata->rb_arg_index = plan->n_rb_args++;
         }
         if (direction == GI_DIRECTION_OUT || direction == GI_DIRECTION_INOUT) {
-            metadata->out_arg_index = out_args->len;
-            g_array_append_val(out_args, argument);
+            metadata->out_arg_index = plan->n_out_args++;
+        }
+        if (direction == GI_DIRECTION_IN && metadata->callback_p) {
+            plan->require_callback_p = TRUE;
         }
-
-        g_ptr_array_add(args_metadata, metadata);
     }
 }
 
 static void
-fill_metadata_inout_argv(GPtrArray *args_metadata)
+invoke_plan_fill_metadata_inout_argv(RBGIInvokePlan *plan)
 {
-    guint i;
+    gint i;
     gint inout_argc_arg_index = -1;
 
-    for (i = 0; i < args_metadata->len; i++) {
+    for (i = 0; i < plan->n_args; i++) {
         RBGIArgMetadata *metadata;
         GIArgInfo *arg_info;
         const gchar *name;
 
-        metadata = g_ptr_array_index(args_metadata, i);
+        metadata = &(plan->args_metadata[i]);
         if (metadata->direction != GI_DIRECTION_INOUT) {
             continue;
         }
@@ -162,17 +169,17 @@ fill_metadata_inout_argv(GPtrArray *args_metadata)
 }
 
 static void
-fill_metadata_callback(GPtrArray *args_metadata)
+invoke_plan_fill_metadata_callback(RBGIInvokePlan *plan)
 {
-    guint i;
+    gint i;
 
-    for (i = 0; i < args_metadata->len; i++) {
+    for (i = 0; i < plan->n_args; i++) {
         RBGIArgMetadata *metadata;
         GIArgInfo *arg_info;
         gint closure_index;
         gint destroy_index;
 
-        metadata = g_ptr_array_index(args_metadata, i);
+        metadata = &(plan->args_metadata[i]);
         if (!metadata->callback_p) {
             continue;
         }
@@ -181,7 +188,7 @@ fill_metadata_callback(GPtrArray *args_metadata)
         closure_index = g_arg_info_get_closure(arg_info);
         if (closure_index != -1) {
             RBGIArgMetadata *closure_metadata;
-            closure_metadata = g_ptr_array_index(args_metadata, closure_index);
+            closure_metadata = &(plan->args_metadata[closure_index]);
             closure_metadata->closure_p = TRUE;
             metadata->closure_in_arg_index = closure_metadata->in_arg_index;
             closure_metadata->rb_arg_index = -1;
@@ -190,7 +197,7 @@ fill_metadata_callback(GPtrArray *args_metadata)
         destroy_index = g_arg_info_get_destroy(arg_info);
         if (destroy_index != -1) {
             RBGIArgMetadata *destroy_metadata;
-            destroy_metadata = g_ptr_array_index(args_metadata, destroy_index);
+            destroy_metadata = &(plan->args_metadata[destroy_index]);
             destroy_metadata->destroy_p = TRUE;
             metadata->destroy_in_arg_index = destroy_metadata->in_arg_index;
             destroy_metadata->rb_arg_index = -1;
@@ -199,10 +206,117 @@ fill_metadata_callback(GPtrArray *args_metadata)
 }
 
 static void
-fill_metadata(GPtrArray *args_metadata)
+invoke_plan_fill_metadata_rb_arg_index(RBGIInvokePlan *plan)
+{
+    gint i;
+
+    /* Closure and destroy arguments are filled by us, not by the
+       caller. Compact Ruby level argument positions after them. */
+    plan->n_rb_args = 0;
+    for (i = 0; i < plan->n_args; i++) {
+        RBGIArgMetadata *metadata;
+
+        metadata = &(plan->args_metadata[i]);
+        if (metadata->rb_arg_index == -1) {
+            continue;
+        }
+        if (metadata->callback_p) {
+            continue;
+        }
+        metadata->rb_arg_index = plan->n_rb_args++;
+    }
+}
+
+static gboolean
+gobject_based_p(GIBaseInfo *info)
+{
+    GIBaseInfo *container_info;
+    GIRegisteredTypeInfo *registered_type_info;
+
+    container_info = g_base_info_get_container(info);
+    if (!container_info) {
+        return TRUE;
+    }
+    if (g_base_info_get_type(container_info) != GI_INFO_TYPE_STRUCT) {
+        return TRUE;
+    }
+
+    registered_type_info = (GIRegisteredTypeInfo *)container_info;
+    if (g_registered_type_info_get_type_init(registered_type_info)) {
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+static RBGIInvokePlan *
+invoke_plan_new(GIFunctionInfo *info)
+{
+    RBGIInvokePlan *plan;
+    GICallableInfo *callable_info;
+    GITypeInfo return_type_info;
+
+    callable_info = (GICallableInfo *)info;
+
+    plan = ALLOC(RBGIInvokePlan);
+    plan->info = (GIFunctionInfo *)g_base_info_ref((GIBaseInfo *)info);
+    plan->method_p =
+        ((g_function_info_get_flags(info) & GI_FUNCTION_IS_METHOD) != 0);
+    plan->gobject_based_p = gobject_based_p((GIBaseInfo *)info);
+    plan->require_callback_p = FALSE;
+    plan->n_args = g_callable_info_get_n_args(callable_info);
+    plan->n_in_args = 0;
+    plan->n_out_args = 0;
+    plan->n_rb_args = 0;
+    g_callable_info_load_return_type(callable_info, &return_type_info);
+    plan->return_type_tag = g_type_info_get_tag(&return_type_info);
+
+    invoke_plan_allocate_arguments(plan);
+    invoke_plan_fill_metadata_inout_argv(plan);
+    invoke_plan_fill_metadata_callback(plan);
+    invoke_plan_fill_metadata_rb_arg_index(plan);
+
+    return plan;
+}
+
+static void
+invoke_plan_free(gpointer data)
+{
+    RBGIInvokePlan *plan = data;
+
+    g_base_info_unref((GIBaseInfo *)(plan->info));
+    xfree(plan->args_metadata);
+    xfree(plan);
+}
+
+RBGIInvokePlan *
+rb_gi_function_info_get_invoke_plan(VALUE rb_info)
+{
+    VALUE rb_plan;
+    RBGIInvokePlan *plan;
+
+    rb_plan = rb_attr_get(rb_info, id_invoke_plan);
+    if (NIL_P(rb_plan)) {
+        plan = invoke_plan_new(RVAL2GI_FUNCTION_INFO(rb_info));
+        rb_plan = Data_Wrap_Struct(rb_cObject, NULL, invoke_plan_free, plan);
+        rb_ivar_set(rb_info, id_invoke_plan, rb_plan);
+    } else {
+        Data_Get_Struct(rb_plan, RBGIInvokePlan, plan);
+    }
+
+    return plan;
+}
+
+gboolean
+rb_gi_invoke_plan_require_callback_p(RBGIInvokePlan *plan)
 {
-    fill_metadata_inout_argv(args_metadata);
-    fill_metadata_callback(args_metadata);
+    return plan->require_callback_p;
+}
+
+gint
+rb_gi_invoke_plan_get_n_rb_args(RBGIInvokePlan *plan)
+{
+    return plan->n_rb_args;
 }
 
 static void
@@ -333,7 +447,7 @@ source_func_callback_finder(GIArgInfo *arg_info)
 }
 
 static void
-in_callback_argument_from_ruby(RBGIArgMetadata *metadata, GArray *in_args)
+in_callback_argument_from_ruby(RBGIArgMetadata *metadata, GIArgument *in_args)
 {
     gpointer callback;
     GIArgInfo *arg_info;
@@ -355,37 +469,35 @@ in_callback_argument_from_ruby(RBGIArgMetadata *metadata, GArray *in_args)
                  g_base_info_get_name(arg_info));
     }
 
-    callback_argument = &(g_array_index(in_args,
-                                        GIArgument,
-                                        metadata->in_arg_index));
+    callback_argument = &(in_args[metadata->in_arg_index]);
     callback_argument->v_pointer = callback;
 
     if (metadata->closure_in_arg_index != -1) {
         RBGICallbackData *callback_data;
         GIArgument *closure_argument;
 
+        /* The metadata is owned by the cached invoke plan. Callback
+           data may outlive this call, so it gets its own copy. */
         callback_data = ALLOC(RBGICallbackData);
-        callback_data->metadata = metadata;
+        callback_data->metadata = ALLOC(RBGIArgMetadata);
+        *(callback_data->metadata) = *metadata;
         callback_data->rb_callback = rb_block_proc();
         callback_data_guard_from_gc(callback_data);
-        closure_argument = &(g_array_index(in_args,
-                                           GIArgument,
-                                           metadata->closure_in_arg_index));
+        closure_argument = &(in_args[metadata->closure_in_arg_index]);
         closure_argument->v_pointer = callback_data;
     }
 
     if (metadata->destroy_in_arg_index != -1) {
         GIArgument *destroy_argument;
-        destroy_argument = &(g_array_index(in_args,
-                                           GIArgument,
-                                           metadata->destroy_in_arg_index));
+        destroy_argument = &(in_args[metadata->destroy_in_arg_index]);
         destroy_argument->v_pointer = destroy_notify;
     }
 }
 
 static void
-in_argument_from_ruby(RBGIArgMetadata *metadata, VALUE rb_arguments,
-                      GArray *in_args)
+in_argument_from_ruby(RBGIArgMetadata *metadata,
+                      int argc, const VALUE *argv,
+                      GIArgument *in_args)
 {
     if (metadata->rb_arg_index == -1) {
         return;
@@ -394,64 +506,51 @@ in_argument_from_ruby(RBGIArgMetadata *metadata, VALUE rb_arguments,
     if (metadata->callback_p) {
         in_callback_argument_from_ruby(metadata, in_args);
     } else {
-        GIArgument *argument;
         VALUE rb_argument = Qnil;
 
-        if (RARRAY_LEN(rb_arguments) > metadata->rb_arg_index) {
-            rb_argument = RARRAY_PTR(rb_arguments)[metadata->rb_arg_index];
+        if (argc > metadata->rb_arg_index) {
+            rb_argument = argv[metadata->rb_arg_index];
         }
-        argument = &(g_array_index(in_args, GIArgument, metadata->in_arg_index));
-        RVAL2GI_IN_ARGUMENT(argument,
+        RVAL2GI_IN_ARGUMENT(&(in_args[metadata->in_arg_index]),
                             &(metadata->arg_info),
                             rb_argument);
     }
 }
 
 static void
-out_argument_from_ruby(RBGIArgMetadata *metadata, GArray *out_args)
-{
-    GIArgument *argument;
-
-    argument = &(g_array_index(out_args, GIArgument, metadata->out_arg_index));
-    rb_gi_out_argument_init(argument, &(metadata->arg_info));
-}
-
-static void
-arg_metadata_free(gpointer data)
+out_argument_from_ruby(RBGIArgMetadata *metadata, GIArgument *out_args)
 {
-    RBGIArgMetadata *metadata = data;
-    if (metadata->scope_type == GI_SCOPE_TYPE_ASYNC ||
-        metadata->scope_type == GI_SCOPE_TYPE_NOTIFIED) {
-        return;
-    }
-    xfree(metadata);
+    rb_gi_out_argument_init(&(out_args[metadata->out_arg_index]),
+                            &(metadata->arg_info));
 }
 
+/* *n_converted_args counts the arguments that are converted
+ * completely, so that arguments_free() can release them when a later
+ * one raises. */
 static void
-arguments_from_ruby(GICallableInfo *info, VALUE rb_arguments,
-                    GArray *in_args, GArray *out_args,
-                    GPtrArray *args_metadata)
+arguments_from_ruby(RBGIInvokePlan *plan, int argc, const VALUE *argv,
+                    GIArgument *in_args, GIArgument *out_args,
+                    gint *n_converted_args)
 {
-    gint i, n_args;
-
-    allocate_arguments(info, in_args, out_args, args_metadata);
-    fill_metadata(args_metadata);
+    gint i;
 
-    n_args = g_callable_info_get_n_args(info);
-    for (i = 0; i < n_args; i++) {
+    memset(in_args, 0, sizeof(GIArgument) * plan->n_in_args);
+    memset(out_args, 0, sizeof(GIArgument) * plan->n_out_args);
+    for (i = 0; i < plan->n_args; i++) {
         RBGIArgMetadata *metadata;
 
-        metadata = g_ptr_array_index(args_metadata, i);
+        metadata = &(plan->args_metadata[i]);
         if (metadata->in_arg_index != -1) {
-            in_argument_from_ruby(metadata, rb_arguments, in_args);
+            in_argument_from_ruby(metadata, argc, argv, in_args);
         } else {
             out_argument_from_ruby(metadata, out_args);
         }
+        (*n_converted_args)++;
     }
 }
 
 static VALUE
-inout_argv_argument_to_ruby(GArray *in_args, RBGIArgMetadata *metadata)
+inout_argv_argument_to_ruby(GIArgument *in_args, RBGIArgMetadata *metadata)
 {
     GIArgument *inout_argc_argument;
     GIArgument *inout_argv_argument;
@@ -459,10 +558,8 @@ inout_argv_argument_to_ruby(GArray *in_args, RBGIArgMetadata *metadata)
     gchar **argv;
     VALUE rb_argv_argument;
 
-    inout_argc_argument = &g_array_index(in_args, GIArgument,
-                                         metadata->inout_argc_arg_index);
-    inout_argv_argument = &g_array_index(in_args, GIArgument,
-                                         metadata->in_arg_index);
+    inout_argc_argument = &(in_args[metadata->inout_argc_arg_index]);
+    inout_argv_argument = &(in_args[metadata->in_arg_index]);
     argc = *((gint *)(inout_argc_argument->v_pointer));
     argv = *((gchar ***)(inout_argv_argument->v_pointer));
     rb_argv_argument = rb_ary_new2(argc);
@@ -473,31 +570,31 @@ inout_argv_argument_to_ruby(GArray *in_args, RBGIArgMetadata *metadata)
 }
 
 static VALUE
-out_arguments_to_ruby(GICallableInfo *callable_info,
-                      GArray *in_args, GArray *out_args,
-                      GPtrArray *args_metadata)
+out_arguments_to_ruby(RBGIInvokePlan *plan,
+                      GIArgument *in_args, GIArgument *out_args)
 {
-    gint i, n_args;
+    gint i;
     VALUE rb_out_args;
 
-    rb_out_args = rb_ary_new();
-    n_args = g_callable_info_get_n_args(callable_info);
-    for (i = 0; i < n_args; i++) {
+    if (plan->n_out_args == 0) {
+        return Qnil;
+    }
+
+    rb_out_args = rb_ary_new2(plan->n_out_args);
+    for (i = 0; i < plan->n_args; i++) {
         RBGIArgMetadata *metadata;
         GIArgument *argument = NULL;
         VALUE rb_argument;
 
-        metadata = g_ptr_array_index(args_metadata, i);
+        metadata = &(plan->args_metadata[i]);
         switch (metadata->direction) {
           case GI_DIRECTION_IN:
             break;
           case GI_DIRECTION_OUT:
-            argument = &g_array_index(out_args, GIArgument,
-                                      metadata->out_arg_index);
+            argument = &(out_args[metadata->out_arg_index]);
             break;
           case GI_DIRECTION_INOUT:
-            argument = &g_array_index(in_args, GIArgument,
-                                      metadata->in_arg_index);
+            argument = &(in_args[metadata->in_arg_index]);
             break;
           default:
             g_assert_not_reached();
@@ -516,56 +613,49 @@ out_arguments_to_ruby(GICallableInfo *callable_info,
         rb_ary_push(rb_out_args, rb_argument);
     }
 
-    if (RARRAY_LEN(rb_out_args) == 0) {
-        return Qnil;
-    } else {
-        return rb_out_args;
-    }
-}
-
-static void
-arguments_init(GArray **in_args, GArray **out_args, GPtrArray **args_metadata)
-{
-    *in_args = g_array_new(FALSE, FALSE, sizeof(GIArgument));
-    *out_args = g_array_new(FALSE, FALSE, sizeof(GIArgument));
-    *args_metadata = g_ptr_array_new_with_free_func(arg_metadata_free);
+    return rb_out_args;
 }
 
+/* Frees the first n_converted_args arguments. Callback data is owned
+ * by the callee once the function is invoked, except for the CALL
+ * scope; if the function isn't invoked, all of it is freed here. */
 static void
-arguments_free(GArray *in_args, GArray *out_args, GPtrArray *args_metadata)
+arguments_free(RBGIInvokePlan *plan, GIArgument *in_args, GIArgument *out_args,
+               gint n_converted_args, gboolean invoked)
 {
-    guint i;
+    gint i;
 
-    for (i = 0; i < args_metadata->len; i++) {
+    for (i = 0; i < n_converted_args; i++) {
         RBGIArgMetadata *metadata;
-        gint in_arg_index;
 
-        metadata = g_ptr_array_index(args_metadata, i);
+        metadata = &(plan->args_metadata[i]);
         if (metadata->direction == GI_DIRECTION_IN ||
             metadata->direction == GI_DIRECTION_INOUT) {
-            in_arg_index = metadata->in_arg_index;
-            if (in_arg_index != -1) {
-                GIArgument *argument;
-                argument = &(g_array_index(in_args, GIArgument, in_arg_index));
-                rb_gi_in_argument_free(argument, &(metadata->arg_info));
+            rb_gi_in_argument_free(&(in_args[metadata->in_arg_index]),
+                                   &(metadata->arg_info));
+            if (metadata->callback_p &&
+                (!invoked || metadata->scope_type == GI_SCOPE_TYPE_CALL) &&
+                metadata->closure_in_arg_index != -1) {
+                RBGICallbackData *callback_data;
+                callback_data =
+                    in_args[metadata->closure_in_arg_index].v_pointer;
+                if (callback_data) {
+                    rb_gi_callback_data_free(callback_data);
+                }
             }
         } else {
-            GIArgument *argument;
-            argument = &(g_array_index(out_args, GIArgument,
-                                       metadata->out_arg_index));
-            rb_gi_out_argument_fin(argument, &(metadata->arg_info));
+            rb_gi_out_argument_fin(&(out_args[metadata->out_arg_index]),
+                                   &(metadata->arg_info));
         }
     }
-
-    g_array_unref(in_args);
-    g_array_unref(out_args);
-    g_ptr_array_unref(args_metadata);
 }
 
 typedef struct {
     GIFunctionInfo *info;
-    GArray *in_args;
-    GArray *out_args;
+    GIArgument *in_args;
+    gint n_in_args;
+    GIArgument *out_args;
+    gint n_out_args;
     GIArgument *return_value;
     GError **error;
     gboolean succeeded;
@@ -576,10 +666,10 @@ rb_gi_function_info_invoke_raw_call(InvokeData *data)
 {
     data->succeeded =
         g_function_info_invoke(data->info,
-                               (GIArgument *)(data->in_args->data),
-                               data->in_args->len,
-                               (GIArgument *)(data->out_args->data),
-                               data->out_args->len,
+                               data->in_args,
+                               data->n_in_args,
+                               data->out_args,
+                               data->n_out_args,
                                data->return_value,
                                data->error);
 }
@@ -594,36 +684,139 @@ rb_gi_function_info_invoke_raw_call_without_gvl_body(void *user_data)
     return RB_THREAD_CALL_WITHOUT_GVL_FUNC_RETURN_VALUE;
 }
 
-static gboolean
-gobject_based_p(GIBaseInfo *info)
+typedef struct {
+    RBGIInvokePlan *plan;
+    VALUE rb_receiver;
+    int argc;
+    const VALUE *argv;
+    gboolean unlock_gvl;
+    GIArgument *return_value;
+    GIArgument *in_args_with_receiver;
+    gint n_in_args_with_receiver;
+    GIArgument *out_args;
+    gint n_converted_args;
+    gboolean invoked;
+    gboolean succeeded;
+    GError *error;
+    VALUE rb_out_args;
+} InvokePositionalData;
+
+static VALUE
+rb_gi_function_info_invoke_positional_body(VALUE value)
 {
-    GIBaseInfo *container_info;
-    GIRegisteredTypeInfo *registered_type_info;
+    InvokePositionalData *data = (InvokePositionalData *)value;
+    RBGIInvokePlan *plan = data->plan;
+    GIArgument *in_args;
 
-    container_info = g_base_info_get_container(info);
-    if (g_base_info_get_type(container_info) != GI_INFO_TYPE_STRUCT) {
-        return TRUE;
+    in_args = data->in_args_with_receiver;
+    if (!NIL_P(data->rb_receiver)) {
+        if (plan->gobject_based_p) {
+            in_args[0].v_pointer = RVAL2GOBJ(data->rb_receiver);
+        } else {
+            in_args[0].v_pointer = DATA_PTR(data->rb_receiver);
+        }
+        in_args++;
     }
 
-    registered_type_info = (GIRegisteredTypeInfo *)container_info;
-    if (g_registered_type_info_get_type_init(registered_type_info)) {
-        return TRUE;
+    arguments_from_ruby(plan, data->argc, data->argv,
+                        in_args, data->out_args,
+                        &(data->n_converted_args));
+    {
+        InvokeData invoke_data;
+        invoke_data.info = plan->info;
+        invoke_data.in_args = data->in_args_with_receiver;
+        invoke_data.n_in_args = data->n_in_args_with_receiver;
+        invoke_data.out_args = data->out_args;
+        invoke_data.n_out_args = plan->n_out_args;
+        invoke_data.return_value = data->return_value;
+        invoke_data.error = &(data->error);
+        data->invoked = TRUE;
+        if (data->unlock_gvl) {
+            rb_thread_call_without_gvl(
+                rb_gi_function_info_invoke_raw_call_without_gvl_body,
+                &invoke_data,
+                NULL, NULL);
+        } else {
+            rb_gi_function_info_invoke_raw_call(&invoke_data);
+        }
+        data->succeeded = invoke_data.succeeded;
     }
 
-    return FALSE;
+    if (data->succeeded) {
+        data->rb_out_args = out_arguments_to_ruby(plan,
+                                                  in_args,
+                                                  data->out_args);
+    }
+
+    return Qnil;
+}
+
+static VALUE
+rb_gi_function_info_invoke_positional_ensure(VALUE value)
+{
+    InvokePositionalData *data = (InvokePositionalData *)value;
+    GIArgument *in_args;
+
+    in_args = data->in_args_with_receiver;
+    if (!NIL_P(data->rb_receiver)) {
+        in_args++;
+    }
+    arguments_free(data->plan, in_args, data->out_args,
+                   data->n_converted_args, data->invoked);
+
+    return Qnil;
+}
+
+VALUE
+rb_gi_function_info_invoke_positional(RBGIInvokePlan *plan,
+                                      VALUE rb_receiver,
+                                      int argc, const VALUE *argv,
+                                      gboolean unlock_gvl,
+                                      GIArgument *return_value)
+{
+    InvokePositionalData data;
+
+    data.plan = plan;
+    data.rb_receiver = rb_receiver;
+    data.argc = argc;
+    data.argv = argv;
+    data.unlock_gvl = unlock_gvl;
+    data.return_value = return_value;
+    data.n_in_args_with_receiver = plan->n_in_args;
+    if (!NIL_P(rb_receiver)) {
+        data.n_in_args_with_receiver++;
+    }
+    data.in_args_with_receiver = ALLOCA_N(GIArgument,
+                                          data.n_in_args_with_receiver + 1);
+    data.out_args = ALLOCA_N(GIArgument, plan->n_out_args + 1);
+    data.n_converted_args = 0;
+    data.invoked = FALSE;
+    data.succeeded = FALSE;
+    data.error = NULL;
+    data.rb_out_args = Qnil;
+
+    rb_ensure(rb_gi_function_info_invoke_positional_body, (VALUE)&data,
+              rb_gi_function_info_invoke_positional_ensure, (VALUE)&data);
+
+    if (!data.succeeded) {
+        RG_RAISE_ERROR(data.error);
+    }
+
+    if (!NIL_P(data.rb_out_args) && RARRAY_LEN(data.rb_out_args) == 1) {
+        VALUE rb_out_arg;
+        rb_out_arg = RARRAY_PTR(data.rb_out_args)[0];
+        if (rb_obj_is_kind_of(rb_out_arg, rb_cGLibError)) {
+            rb_exc_raise(rb_out_arg);
+        }
+    }
+
+    return data.rb_out_args;
 }
 
 VALUE
-rb_gi_function_info_invoke_raw(GIFunctionInfo *info, VALUE rb_options,
+rb_gi_function_info_invoke_raw(RBGIInvokePlan *plan, VALUE rb_options,
                                GIArgument *return_value)
 {
-    GICallableInfo *callable_info;
-    GIArgument receiver;
-    GArray *in_args, *out_args;
-    GPtrArray *args_metadata;
-    VALUE rb_out_args = Qnil;
-    gboolean succeeded;
-    GError *error = NULL;
     gboolean unlock_gvl = FALSE;
     VALUE rb_receiver, rb_arguments, rb_unlock_gvl;
 
@@ -644,103 +837,95 @@ rb_gi_function_info_invoke_raw(GIFunctionInfo *info, VALUE rb_options,
                          NULL);
     }
 
-    if (NIL_P(rb_receiver)) {
-        receiver.v_pointer = NULL;
-    } else {
-        if (gobject_based_p((GIBaseInfo *)info)) {
-            receiver.v_pointer = RVAL2GOBJ(rb_receiver);
-        } else {
-            receiver.v_pointer = DATA_PTR(rb_receiver);
-        }
-    }
     rb_arguments = rbg_to_array(rb_arguments);
     if (!NIL_P(rb_unlock_gvl) && RVAL2CBOOL(rb_unlock_gvl)) {
         unlock_gvl = TRUE;
     }
 
-    callable_info = (GICallableInfo *)info;
-    arguments_init(&in_args, &out_args, &args_metadata);
-    if (receiver.v_pointer) {
-        g_array_append_val(in_args, receiver);
-    }
-    arguments_from_ruby(callable_info, rb_arguments,
-                        in_args, out_args, args_metadata);
-    {
-        InvokeData data;
-        data.info = info;
-        data.in_args = in_args;
-        data.out_args = out_args;
-        data.return_value = return_value;
-        data.error = &error;
-        if (unlock_gvl) {
-            rb_thread_call_without_gvl(
-                rb_gi_function_info_invoke_raw_call_without_gvl_body, &data,
-                NULL, NULL);
-        } else {
-            rb_gi_function_info_invoke_raw_call(&data);
-        }
-        succeeded = data.succeeded;
-    }
+    return rb_gi_function_info_invoke_positional(plan,
+                                                 rb_receiver,
+                                                 RARRAY_LEN(rb_arguments),
+                                                 RARRAY_PTR(rb_arguments),
+                                                 unlock_gvl,
+                                                 return_value);
+}
 
-    if (succeeded) {
-        rb_out_args = out_arguments_to_ruby(callable_info,
-                                            in_args, out_args,
-                                            args_metadata);
-    }
-    arguments_free(in_args, out_args, args_metadata);
-    if (!succeeded) {
-        RG_RAISE_ERROR(error);
-    }
+VALUE
+rb_gi_function_info_invoke_result(RBGIInvokePlan *plan,
+                                  VALUE rb_out_args,
+                                  GIArgument *return_value)
+{
+    VALUE rb_return_value;
 
-    if (!NIL_P(rb_out_args) && RARRAY_LEN(rb_out_args) == 1) {
-        VALUE rb_out_arg;
-        rb_out_arg = RARRAY_PTR(rb_out_args)[0];
-        if (rb_obj_is_kind_of(rb_out_arg, rb_cGLibError)) {
-            rb_exc_raise(rb_out_arg);
-        }
+    rb_return_value = GI_RETURN_ARGUMENT2RVAL(return_value,
+                                              (GICallableInfo *)(plan->info));
+    if (NIL_P(rb_out_args)) {
+        return rb_return_value;
     }
 
-    return rb_out_args;
+    if (plan->return_type_tag != GI_TYPE_TAG_VOID) {
+        rb_ary_unshift(rb_out_args, rb_return_value);
+    }
+    if (RARRAY_LEN(rb_out_args) == 1) {
+        return RARRAY_PTR(rb_out_args)[0];
+    } else {
+        return rb_out_args;
+    }
 }
 
 static VALUE
 rg_invoke(VALUE self, VALUE rb_options)
 {
-    GIFunctionInfo *info;
-    GICallableInfo *callable_info;
+    RBGIInvokePlan *plan;
     GIArgument return_value;
     VALUE rb_out_args;
-    VALUE rb_return_value;
 
-    info = SELF(self);
-    /* TODO: use rb_protect() */
-    rb_out_args = rb_gi_function_info_invoke_raw(info,
+    plan = rb_gi_function_info_get_invoke_plan(self);
+    rb_out_args = rb_gi_function_info_invoke_raw(plan,
                                                  rb_options,
                                                  &return_value);
+    return rb_gi_function_info_invoke_result(plan, rb_out_args, &return_value);
+}
 
-    callable_info = (GICallableInfo *)info;
-    rb_return_value = GI_RETURN_ARGUMENT2RVAL(&return_value, callable_info);
+static VALUE
+rg_invoke_positional(int argc, VALUE *argv, VALUE self)
+{
+    RBGIInvokePlan *plan;
+    GIArgument return_value;
+    VALUE rb_receiver = Qnil;
+    VALUE rb_out_args;
 
-    if (NIL_P(rb_out_args)) {
-        return rb_return_value;
-    } else {
-        GITypeInfo return_value_info;
-        g_callable_info_load_return_type(callable_info, &return_value_info);
-        if (g_type_info_get_tag(&return_value_info) != GI_TYPE_TAG_VOID) {
-            rb_ary_unshift(rb_out_args, rb_return_value);
-        }
-        if (RARRAY_LEN(rb_out_args) == 1) {
-            return RARRAY_PTR(rb_out_args)[0];
-        } else {
-            return rb_out_args;
+    plan = rb_gi_function_info_get_invoke_plan(self);
+    if (plan->method_p) {
+        if (argc < 1) {
+            rb_raise(rb_eArgError,
+                     "receiver is missing: %s",
+                     g_function_info_get_symbol(plan->info));
         }
+        rb_receiver = argv[0];
+        argc--;
+        argv++;
+    }
+    if (argc > plan->n_rb_args) {
+        rb_raise(rb_eArgError,
+                 "%s: wrong number of arguments (%d for %d)",
+                 g_function_info_get_symbol(plan->info),
+                 argc,
+                 plan->n_rb_args);
     }
+    rb_out_args = rb_gi_function_info_invoke_positional(plan,
+                                                        rb_receiver,
+                                                        argc, argv,
+                                                        FALSE,
+                                                        &return_value);
+    return rb_gi_function_info_invoke_result(plan, rb_out_args, &return_value);
 }
 
 void
 rb_gi_function_info_init(VALUE rb_mGI, VALUE rb_cGICallableInfo)
 {
     rb_cGLibError = rb_const_get(mGLib, rb_intern("Error"));
+    id_invoke_plan = rb_intern("gi_invoke_plan");
 
     RG_TARGET_NAMESPACE =
 	G_DEF_CLASS_WITH_PARENT(GI_TYPE_FUNCTION_INFO, "FunctionInfo", rb_mGI,
@@ -756,6 +941,7 @@ rb_gi_function_info_init(VALUE rb_mGI, VALUE rb_cGICallableInfo)
     RG_DEF_METHOD(property, 0);
     RG_DEF_METHOD(vfunc, 0);
     RG_DEF_METHOD(invoke, 1);
+    RG_DEF_METHOD(invoke_positional, -1);
 
     G_DEF_CLASS(G_TYPE_I_FUNCTION_INFO_FLAGS, "FunctionInfoFlags", rb_mGI);
 
@@ -23,6 +23,7 @@
 #define RG_TARGET_NAMESPACE rb_cGILoader
 
 static const gchar *boxed_class_converters_name = "@@boxed_class_converters";
+static ID id_invokers;
 
 static VALUE
 rg_s_define_class(int argc, VALUE *argv, G_GNUC_UNUSED VALUE klass)
@@ -143,6 +144,239 @@ rg_s_register_boxed_class_converter(VALUE klass, VALUE rb_gtype)
     return Qnil;
 }
 
+typedef struct {
+    VALUE rb_info;
+    RBGIInvokePlan *plan;
+    gboolean receiver_p;
+    gboolean unlock_gvl;
+    gboolean require_callback_p;
+    gint n_in_args;
+    gint n_required_in_args;
+    gchar *method_name;
+} Invoker;
+
+static void
+invoker_free(gpointer data)
+{
+    Invoker *invoker = data;
+    g_free(invoker->method_name);
+    g_free(invoker);
+}
+
+static void
+invokers_mark_invoker(G_GNUC_UNUSED gpointer key,
+                      gpointer value,
+                      G_GNUC_UNUSED gpointer user_data)
+{
+    Invoker *invoker = value;
+    rb_gc_mark(invoker->rb_info);
+}
+
+static void
+invokers_mark(gpointer data)
+{
+    GHashTable *invokers = data;
+    g_hash_table_foreach(invokers, invokers_mark_invoker, NULL);
+}
+
+static void
+invokers_free(gpointer data)
+{
+    GHashTable *invokers = data;
+    g_hash_table_unref(invokers);
+}
+
+static GHashTable *
+invokers_get(VALUE klass, gboolean create)
+{
+    VALUE rb_invokers;
+    GHashTable *invokers;
+
+    rb_invokers = rb_attr_get(klass, id_invokers);
+    if (NIL_P(rb_invokers)) {
+        if (!create) {
+            return NULL;
+        }
+        invokers = g_hash_table_new_full(g_direct_hash, g_direct_equal,
+                                         NULL, invoker_free);
+        rb_invokers = Data_Wrap_Struct(rb_cObject,
+                                       invokers_mark, invokers_free,
+                                       invokers);
+        rb_ivar_set(klass, id_invokers, rb_invokers);
+    } else {
+        Data_Get_Struct(rb_invokers, GHashTable, invokers);
+    }
+
+    return invokers;
+}
+
+static VALUE
+invoker_dispatch(int argc, VALUE *argv, VALUE self)
+{
+    ID id_method;
+    VALUE klass;
+    GHashTable *invokers = NULL;
+    Invoker *invoker = NULL;
+    VALUE rb_receiver = Qnil;
+    GIArgument return_value;
+    VALUE rb_out_args;
+
+    if (rb_frame_method_id_and_class(&id_method, &klass)) {
+        invokers = invokers_get(klass, FALSE);
+    }
+    if (invokers) {
+        invoker = g_hash_table_lookup(invokers, GUINT_TO_POINTER(id_method));
+    }
+    if (!invoker) {
+        rb_raise(rb_eNotImpError,
+                 "BUG: GObject Introspection based method isn't registered");
+    }
+
+    if (argc < invoker->n_required_in_args || invoker->n_in_args < argc) {
+        if (invoker->n_in_args == invoker->n_required_in_args) {
+            rb_raise(rb_eArgError,
+                     "%s: wrong number of arguments (%d for %d)",
+                     invoker->method_name,
+                     argc,
+                     invoker->n_in_args);
+        } else {
+            rb_raise(rb_eArgError,
+                     "%s: wrong number of arguments (%d for %d..%d)",
+                     invoker->method_name,
+                     argc,
+                     invoker->n_required_in_args,
+                     invoker->n_in_args);
+        }
+    }
+
+    if (invoker->require_callback_p && !rb_block_given_p()) {
+        return rb_enumeratorize(self, ID2SYM(id_method), argc, argv);
+    }
+
+    if (invoker->receiver_p) {
+        rb_receiver = self;
+    }
+    rb_out_args = rb_gi_function_info_invoke_positional(invoker->plan,
+                                                        rb_receiver,
+                                                        argc, argv,
+                                                        invoker->unlock_gvl,
+                                                        &return_value);
+    return rb_gi_function_info_invoke_result(invoker->plan,
+                                             rb_out_args,
+                                             &return_value);
+}
+
+static void
+invoker_register(VALUE klass, VALUE rb_name, VALUE rb_info,
+                 gboolean receiver_p, VALUE rb_unlock_gvl,
+                 VALUE rb_metadata, const gchar *method_name)
+{
+    Invoker *invoker;
+    GHashTable *invokers;
+    VALUE rb_n_in_args = Qnil;
+    VALUE rb_n_required_in_args = Qnil;
+
+    /* The metadata may have other values derived by the loader
+       such as :name. We just use what we need. */
+    rb_metadata = rbg_check_hash_type(rb_metadata);
+    if (!NIL_P(rb_metadata)) {
+        rb_n_in_args =
+            rb_hash_aref(rb_metadata, ID2SYM(rb_intern("n_in_args")));
+        rb_n_required_in_args =
+            rb_hash_aref(rb_metadata, ID2SYM(rb_intern("n_required_in_args")));
+    }
+    if (NIL_P(rb_n_in_args)) {
+        ID id_n_in_args;
+        CONST_ID(id_n_in_args, "n_in_args");
+        rb_n_in_args = rb_funcall(rb_info, id_n_in_args, 0);
+    }
+    if (NIL_P(rb_n_required_in_args)) {
+        ID id_n_required_in_args;
+        CONST_ID(id_n_required_in_args, "n_required_in_args");
+        rb_n_required_in_args = rb_funcall(rb_info, id_n_required_in_args, 0);
+    }
+
+    invoker = g_new(Invoker, 1);
+    invoker->rb_info = rb_info;
+    invoker->plan = rb_gi_function_info_get_invoke_plan(rb_info);
+    invoker->receiver_p = receiver_p;
+    invoker->unlock_gvl = RVAL2CBOOL(rb_unlock_gvl);
+    invoker->require_callback_p =
+        rb_gi_invoke_plan_require_callback_p(invoker->plan);
+    invoker->n_in_args = NUM2INT(rb_n_in_args);
+    invoker->n_required_in_args = NUM2INT(rb_n_required_in_args);
+    invoker->method_name = g_strdup(method_name);
+
+    invokers = invokers_get(klass, TRUE);
+    g_hash_table_replace(invokers,
+                         GUINT_TO_POINTER(rb_intern(RVAL2CSTR(rb_name))),
+                         invoker);
+}
+
+static VALUE
+rg_s_define_method_invoker(int argc, VALUE *argv, G_GNUC_UNUSED VALUE klass)
+{
+    VALUE rb_info, rb_class, rb_name, rb_unlock_gvl, rb_metadata;
+    const gchar *name;
+    gchar *method_name;
+
+    rb_scan_args(argc, argv, "41",
+                 &rb_info, &rb_class, &rb_name, &rb_unlock_gvl, &rb_metadata);
+    rb_name = rb_obj_as_string(rb_name);
+    name = RVAL2CSTR(rb_name);
+    method_name = g_strdup_printf("%s#%s", RBG_INSPECT(rb_class), name);
+    invoker_register(rb_class, rb_name, rb_info, TRUE, rb_unlock_gvl,
+                     rb_metadata, method_name);
+    g_free(method_name);
+    rb_define_method(rb_class, name, invoker_dispatch, -1);
+
+    return Qnil;
+}
+
+static VALUE
+rg_s_define_singleton_method_invoker(int argc, VALUE *argv,
+                                     G_GNUC_UNUSED VALUE klass)
+{
+    VALUE rb_info, rb_class, rb_name, rb_unlock_gvl, rb_metadata;
+    const gchar *name;
+    gchar *method_name;
+
+    rb_scan_args(argc, argv, "41",
+                 &rb_info, &rb_class, &rb_name, &rb_unlock_gvl, &rb_metadata);
+    rb_name = rb_obj_as_string(rb_name);
+    name = RVAL2CSTR(rb_name);
+    method_name = g_strdup_printf("%s.%s", RBG_INSPECT(rb_class), name);
+    invoker_register(rb_singleton_class(rb_class), rb_name, rb_info, FALSE,
+                     rb_unlock_gvl, rb_metadata, method_name);
+    g_free(method_name);
+    rb_define_singleton_method(rb_class, name, invoker_dispatch, -1);
+
+    return Qnil;
+}
+
+static VALUE
+rg_s_define_module_function_invoker(int argc, VALUE *argv,
+                                    G_GNUC_UNUSED VALUE klass)
+{
+    VALUE rb_info, rb_module, rb_name, rb_unlock_gvl, rb_metadata;
+    const gchar *name;
+    gchar *method_name;
+
+    rb_scan_args(argc, argv, "41",
+                 &rb_info, &rb_module, &rb_name, &rb_unlock_gvl, &rb_metadata);
+    rb_name = rb_obj_as_string(rb_name);
+    name = RVAL2CSTR(rb_name);
+    method_name = g_strdup_printf("%s.%s", RBG_INSPECT(rb_module), name);
+    invoker_register(rb_module, rb_name, rb_info, FALSE,
+                     rb_unlock_gvl, rb_metadata, method_name);
+    invoker_register(rb_singleton_class(rb_module), rb_name, rb_info, FALSE,
+                     rb_unlock_gvl, rb_metadata, method_name);
+    g_free(method_name);
+    rb_define_module_function(rb_module, name, invoker_dispatch, -1);
+
+    return Qnil;
+}
+
 static VALUE
 rg_s_start_callback_dispatch_thread(G_GNUC_UNUSED VALUE klass)
 {
@@ -157,11 +391,16 @@ rb_gi_loader_init(VALUE rb_mGI)
 
     RG_TARGET_NAMESPACE = rb_define_class_under(rb_mGI, "Loader", rb_cObject);
 
+    id_invokers = rb_intern("gi_invokers");
+
     rb_cv_set(RG_TARGET_NAMESPACE, boxed_class_converters_name, rb_ary_new());
 
     RG_DEF_SMETHOD(define_class, -1);
     RG_DEF_SMETHOD(define_interface, 3);
     RG_DEF_SMETHOD(define_struct, -1);
+    RG_DEF_SMETHOD(define_method_invoker, -1);
+    RG_DEF_SMETHOD(define_singleton_method_invoker, -1);
+    RG_DEF_SMETHOD(define_module_function_invoker, -1);
     RG_DEF_SMETHOD(register_boxed_class_converter, 1);
     RG_DEF_SMETHOD(start_callback_dispatch_thread, 0);
 }
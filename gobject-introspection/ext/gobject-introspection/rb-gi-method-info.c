@@ -38,36 +38,17 @@ gi_method_info_get_type(void)
 static VALUE
 rg_invoke(VALUE self, VALUE rb_options)
 {
-    GIFunctionInfo *info;
-    GICallableInfo *callable_info;
+    RBGIInvokePlan *plan;
     GIArgument return_value;
     VALUE rb_out_args;
-    VALUE rb_return_value;
 
-    info = SELF(self);
+    plan = rb_gi_function_info_get_invoke_plan(self);
 
     /* TODO: use rb_protect */
-    rb_out_args = rb_gi_function_info_invoke_raw(info,
+    rb_out_args = rb_gi_function_info_invoke_raw(plan,
                                                  rb_options,
                                                  &return_value);
-
-    callable_info = (GICallableInfo *)info;
-    rb_return_value = GI_RETURN_ARGUMENT2RVAL(&return_value, callable_info);
-
-    if (NIL_P(rb_out_args)) {
-        return rb_return_value;
-    } else {
-        GITypeInfo return_value_info;
-        g_callable_info_load_return_type(callable_info, &return_value_info);
-        if (g_type_info_get_tag(&return_value_info) != GI_TYPE_TAG_VOID) {
-            rb_ary_unshift(rb_out_args, rb_return_value);
-        }
-        if (RARRAY_LEN(rb_out_args) == 1) {
-            return RARRAY_PTR(rb_out_args)[0];
-        } else {
-            return rb_out_args;
-        }
-    }
+    return rb_gi_function_info_invoke_result(plan, rb_out_args, &return_value);
 }
 
 void
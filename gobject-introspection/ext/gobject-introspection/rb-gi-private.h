@@ -92,9 +92,28 @@ void rb_gi_unresolved_info_init      (VALUE rb_mGI,
 void rb_gi_repository_init           (VALUE rb_mGI);
 void rb_gi_loader_init               (VALUE rb_mGI);
 
-VALUE rb_gi_function_info_invoke_raw (GIFunctionInfo *info,
+typedef struct RBGIInvokePlan_ RBGIInvokePlan;
+
+RBGIInvokePlan *rb_gi_function_info_get_invoke_plan
+                                     (VALUE rb_info);
+gboolean rb_gi_invoke_plan_require_callback_p
+                                     (RBGIInvokePlan *plan);
+gint  rb_gi_invoke_plan_get_n_rb_args(RBGIInvokePlan *plan);
+
+VALUE rb_gi_function_info_invoke_raw (RBGIInvokePlan *plan,
                                       VALUE rb_options,
                                       GIArgument *return_value);
+VALUE rb_gi_function_info_invoke_positional
+                                     (RBGIInvokePlan *plan,
+                                      VALUE rb_receiver,
+                                      int argc,
+                                      const VALUE *argv,
+                                      gboolean unlock_gvl,
+                                      GIArgument *return_value);
+VALUE rb_gi_function_info_invoke_result
+                                     (RBGIInvokePlan *plan,
+                                      VALUE rb_out_args,
+                                      GIArgument *return_value);
 
 VALUE rb_gi_field_info_get_field_raw (GIFieldInfo *info,
                                       gpointer     memory);
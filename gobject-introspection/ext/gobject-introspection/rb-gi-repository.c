@@ -93,6 +93,24 @@ rg_loaded_namespaces(VALUE self)
     return rb_namespaces;
 }
 
+static VALUE
+rg_get_version(VALUE self, VALUE rb_namespace)
+{
+    const gchar *namespace_;
+
+    namespace_ = RVAL2CSTR(rb_namespace);
+    return CSTR2RVAL(g_irepository_get_version(SELF(self), namespace_));
+}
+
+static VALUE
+rg_get_typelib_path(VALUE self, VALUE rb_namespace)
+{
+    const gchar *namespace_;
+
+    namespace_ = RVAL2CSTR(rb_namespace);
+    return CSTR2RVAL(g_irepository_get_typelib_path(SELF(self), namespace_));
+}
+
 static VALUE
 rg_get_n_infos(VALUE self, VALUE rb_namespace)
 {
@@ -155,6 +173,8 @@ rb_gi_repository_init(VALUE rb_mGI)
     RG_DEF_METHOD(require, -1);
     RG_DEF_METHOD(get_dependencies, 1);
     RG_DEF_METHOD(loaded_namespaces, 0);
+    RG_DEF_METHOD(get_version, 1);
+    RG_DEF_METHOD(get_typelib_path, 1);
     RG_DEF_METHOD(get_n_infos, 1);
     RG_DEF_METHOD(get_info, 2);
     RG_DEF_METHOD(find, -1);
@@ -50,4 +50,6 @@ require "gobject-introspection/interface-info"
 require "gobject-introspection/struct-info"
 require "gobject-introspection/boxed-info"
 require "gobject-introspection/union-info"
+require "gobject-introspection/lazy-loader"
+require "gobject-introspection/loader-cache"
 require "gobject-introspection/loader"
@@ -0,0 +1,204 @@
+# Copyright (C) 2013  Ruby-GNOME2 Project Team
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+module GObjectIntrospection
+  # Keeps method and field definitions of classes and modules
+  # pending until they are used for the first time.
+  module LazyLoader
+    @n_running_loaders = 0
+
+    class << self
+      def running
+        @n_running_loaders += 1
+        begin
+          yield
+        ensure
+          @n_running_loaders -= 1
+        end
+      end
+
+      def running?
+        @n_running_loaders > 0
+      end
+
+      def register(target, &loader)
+        loaders = target.instance_variable_get(:@gi_lazy_loaders)
+        if loaders.nil?
+          loaders = []
+          target.instance_variable_set(:@gi_lazy_loaders, loaders)
+        end
+        loaders << loader
+      end
+
+      def enable_instance_methods(klass)
+        return if klass.include?(InstanceMethods)
+        klass.__send__(:include, InstanceMethods)
+      end
+
+      def enable_singleton_methods(target)
+        singleton_class = (class << target; self; end)
+        return if singleton_class.include?(SingletonMethods)
+        target.extend(SingletonMethods)
+      end
+
+      def pending?(target)
+        loaders = target.instance_variable_get(:@gi_lazy_loaders)
+        not (loaders.nil? or loaders.empty?)
+      end
+
+      def load(target)
+        return false unless pending?(target)
+        loaders = target.instance_variable_get(:@gi_lazy_loaders)
+        target.instance_variable_set(:@gi_lazy_loaders, [])
+        running do
+          loaders.each do |loader|
+            loader.call
+          end
+        end
+        true
+      end
+
+      def load_ancestors(target)
+        loaded = false
+        target.ancestors.each do |ancestor|
+          loaded = true if load(ancestor)
+        end
+        loaded
+      end
+
+      # Defines a method that loads pending definitions and calls the
+      # loaded one. It is needed for names that Object already has
+      # because method_missing isn't used for them. The loaded
+      # definition replaces the stub.
+      def define_stub(klass, name)
+        klass.__send__(:define_method, name) do |*arguments, &block|
+          if LazyLoader.load_ancestors(self.class)
+            __send__(name, *arguments, &block)
+          else
+            super(*arguments, &block)
+          end
+        end
+      end
+
+      # Same as define_stub but for a singleton method of target.
+      def define_singleton_stub(target, name)
+        singleton_class = (class << target; self; end)
+        singleton_class.__send__(:define_method, name) do |*arguments, &block|
+          if LazyLoader.load_ancestors(self)
+            __send__(name, *arguments, &block)
+          else
+            super(*arguments, &block)
+          end
+        end
+      end
+
+      # Defines the pending definitions of target before Ruby code
+      # changes them and keeps the Ruby definition of name.
+      def load_before_override(target, name, singleton)
+        return if running?
+        return unless pending?(target)
+
+        if singleton
+          method = target.method(name).unbind
+          load(target)
+          target.__send__(:define_singleton_method, name, method)
+        else
+          visibility = method_visibility(target, name)
+          method = target.instance_method(name)
+          load(target)
+          target.__send__(:define_method, name, method)
+          target.__send__(visibility, name)
+        end
+      end
+
+      private
+      def method_visibility(target, name)
+        if target.private_method_defined?(name)
+          :private
+        elsif target.protected_method_defined?(name)
+          :protected
+        else
+          :public
+        end
+      end
+    end
+
+    module InstanceMethods
+      private
+      def method_missing(name, *arguments, &block)
+        if LazyLoader.load_ancestors(self.class) and respond_to?(name, true)
+          __send__(name, *arguments, &block)
+        else
+          super
+        end
+      end
+
+      def respond_to_missing?(name, include_private)
+        if LazyLoader.load_ancestors(self.class)
+          respond_to?(name, include_private)
+        else
+          super
+        end
+      end
+    end
+
+    module SingletonMethods
+      private
+      def method_missing(name, *arguments, &block)
+        if LazyLoader.load_ancestors(self) and respond_to?(name, true)
+          __send__(name, *arguments, &block)
+        else
+          super
+        end
+      end
+
+      def respond_to_missing?(name, include_private)
+        if LazyLoader.load_ancestors(self)
+          respond_to?(name, include_private)
+        else
+          super
+        end
+      end
+
+      # Methods overridden in a user defined subclass may call
+      # super. It can't be resolved by method_missing. So we define
+      # all pending methods before the subclass is used.
+      def inherited(subclass)
+        LazyLoader.load_ancestors(self) unless LazyLoader.running?
+        super
+      end
+
+      # Ruby code may alias or override loaded methods after the
+      # namespace is loaded. Pending definitions are defined before
+      # that so that they neither are missing nor replace the Ruby
+      # definitions later.
+      def alias_method(new_name, old_name)
+        LazyLoader.load_ancestors(self) unless LazyLoader.running?
+        super
+      end
+
+      def method_added(name)
+        super
+        LazyLoader.load_before_override(self, name, false)
+      end
+
+      def singleton_method_added(name)
+        super
+        LazyLoader.load_before_override(self, name, true)
+      end
+    end
+  end
+end
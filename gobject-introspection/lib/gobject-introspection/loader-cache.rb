@@ -0,0 +1,167 @@
+# Copyright (C) 2013  Ruby-GNOME2 Project Team
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+require "digest/sha1"
+require "fileutils"
+require "json"
+
+module GObjectIntrospection
+  # Stores values derived from a typelib by a loader, such as Ruby-ish
+  # method names and argument counts, across processes. A cache file
+  # is used only while the loader class, the namespace, its version,
+  # the typelib file and the Ruby code of the loader are unchanged.
+  #
+  # Cache files are JSON so that loading one from a shared directory
+  # can't run code planted there.
+  class LoaderCache
+    FORMAT_VERSION = 2
+
+    class << self
+      # The directory to store cache files. Caching is disabled when
+      # it is nil. RUBY_GNOME2_GI_CACHE_DIR environment variable is
+      # used by default.
+      attr_writer :directory
+      def directory
+        @directory || ENV["RUBY_GNOME2_GI_CACHE_DIR"]
+      end
+
+      def open(loader_class, repository, namespace)
+        directory = self.directory
+        return new(nil, nil) if directory.nil?
+
+        version = repository.get_version(namespace)
+        typelib_path = repository.get_typelib_path(namespace)
+        begin
+          typelib_stat = File.stat(typelib_path)
+        rescue SystemCallError, TypeError
+          return new(nil, nil)
+        end
+        key = [
+          FORMAT_VERSION,
+          code_digest(loader_class),
+          loader_class.name,
+          namespace,
+          version,
+          typelib_path,
+          typelib_stat.mtime.to_i,
+          typelib_stat.size,
+        ]
+        base_name = [loader_class.name, namespace, version].join("-")
+        base_name = base_name.gsub(/[^a-zA-Z0-9.\-]/, "_")
+        new(File.join(directory, "#{base_name}.cache"), key)
+      end
+
+      # A digest of the files that define loader_class and its
+      # ancestors up to Loader, including this file. Cached values
+      # depend on how that code names and shapes methods, so any
+      # change to it, e.g. by a gem upgrade, invalidates the cache.
+      def code_digest(loader_class)
+        @code_digests ||= {}
+        @code_digests[loader_class] ||= compute_code_digest(loader_class)
+      end
+
+      private
+      def compute_code_digest(loader_class)
+        paths = [__FILE__]
+        loader_class.ancestors.each do |ancestor|
+          next unless ancestor.is_a?(Class)
+          next unless ancestor <= Loader
+          ancestor.instance_methods(false).each do |name|
+            location = ancestor.instance_method(name).source_location
+            paths << location[0] if location
+          end
+          ancestor.private_instance_methods(false).each do |name|
+            location = ancestor.instance_method(name).source_location
+            paths << location[0] if location
+          end
+        end
+        digest = Digest::SHA1.new
+        digest << GLib::BINDING_VERSION.join(".") if defined?(GLib::BINDING_VERSION)
+        paths.uniq.sort.each do |path|
+          digest << path
+          begin
+            digest << File.binread(path)
+          rescue SystemCallError
+          end
+        end
+        digest.hexdigest
+      end
+    end
+
+    attr_reader :path
+    def initialize(path, key)
+      @path = path
+      @key = key
+      @entries = {}
+      @dirty = false
+      load unless @path.nil?
+    end
+
+    def fetch(category, name)
+      entries = (@entries[category] ||= {})
+      return entries[name] if entries.has_key?(name)
+      @dirty = true
+      entries[name] = yield
+    end
+
+    def save
+      return if @path.nil?
+      return unless @dirty
+
+      temporary_path = "#{@path}.#{Process.pid}"
+      begin
+        FileUtils.mkdir_p(File.dirname(@path))
+        File.open(temporary_path, "wb") do |file|
+          file.write(JSON.generate([@key, @entries]))
+        end
+        File.rename(temporary_path, @path)
+        @dirty = false
+      rescue SystemCallError
+        FileUtils.rm_f(temporary_path)
+      end
+    end
+
+    private
+    def load
+      key, entries = JSON.parse(File.read(@path))
+      return unless key == @key
+      return unless entries.is_a?(Hash)
+      @entries = {}
+      entries.each do |category, category_entries|
+        next unless category_entries.is_a?(Hash)
+        @entries[category.to_sym] = restore_entries(category_entries)
+      end
+    rescue SystemCallError, JSON::ParserError, TypeError
+      @entries = {}
+    end
+
+    # JSON turns Symbol keys of values into String keys.
+    def restore_entries(entries)
+      restored = {}
+      entries.each do |name, value|
+        if value.is_a?(Hash)
+          symbolized_value = {}
+          value.each do |key, sub_value|
+            symbolized_value[key.to_sym] = sub_value
+          end
+          value = symbolized_value
+        end
+        restored[name] = value
+      end
+      restored
+    end
+  end
+end
@@ -20,24 +20,45 @@ module GObjectIntrospection
       def load(namespace, base_module, options={})
         loader = new(base_module)
         loader.version = options[:version]
+        loader.lazy = options[:lazy] if options.has_key?(:lazy)
         loader.load(namespace)
       end
     end
 
     attr_accessor :version
+    # If true, methods and fields aren't defined until one of them is
+    # used for the first time. Classes, modules and constants are
+    # always defined. It is false by default and should only be
+    # enabled by loaders whose Ruby code is ready for it.
+    attr_writer :lazy
     def initialize(base_module)
       @base_module = base_module
       @version = nil
+      @lazy = false
+    end
+
+    def lazy?
+      @lazy
     end
 
     def load(namespace)
       repository = Repository.default
       repository.require(namespace, @version)
-      pre_load(repository, namespace)
-      repository.each(namespace) do |info|
-        load_info(info)
+      @cache = LoaderCache.open(self.class, repository, namespace)
+      LazyLoader.running do
+        pre_load(repository, namespace)
+        repository.each(namespace) do |info|
+          load_info(info)
+        end
+        post_load(repository, namespace)
+      end
+      @cache.save
+      if @lazy
+        cache = @cache
+        at_exit do
+          cache.save
+        end
       end
-      post_load(repository, namespace)
     end
 
     private
@@ -71,27 +92,52 @@ module GObjectIntrospection
     end
 
     def load_function_info(info)
-      name = rubyish_method_name(info)
+      if @lazy
+        LazyLoader.enable_singleton_methods(@base_module)
+        name = callable_metadata(info, @base_module)[:name]
+        if singleton_method_defined?(@base_module, name)
+          LazyLoader.define_singleton_stub(@base_module, name)
+        end
+        LazyLoader.register(@base_module) do
+          load_function_info_without_lazy(info)
+        end
+      else
+        load_function_info_without_lazy(info)
+      end
+    end
+
+    def load_function_info_without_lazy(info)
+      name = callable_metadata(info, @base_module)[:name]
       define_module_function(@base_module, name, info)
     end
 
     def define_module_function(target_module, name, function_info)
       unlock_gvl = should_unlock_gvl?(function_info, target_module)
-      validate = lambda do |arguments|
-        method_name = "#{target_module}\#.#{name}"
-        validate_arguments(function_info, method_name, arguments)
-      end
-      target_module.module_eval do
-        define_method(name) do |*arguments, &block|
-          validate.call(arguments, &block)
-          function_info.invoke({
-                                 :arguments => arguments,
-                                 :unlock_gvl => unlock_gvl,
-                               },
-                               &block)
-        end
-        module_function(name)
+      self.class.define_module_function_invoker(function_info,
+                                                target_module,
+                                                name,
+                                                unlock_gvl,
+                                                callable_metadata(function_info,
+                                                                  target_module))
+    end
+
+    # Returns values derived from the callable info. They are cached
+    # across processes by LoaderCache.
+    def callable_metadata(info, container)
+      compute = lambda do
+        {
+          :name               => rubyish_method_name(info),
+          :n_args             => info.n_args,
+          :n_in_args          => info.n_in_args,
+          :n_required_in_args => info.n_required_in_args,
+        }
       end
+      container_name = container.name
+      return compute.call if container_name.nil? or @cache.nil?
+      # A method and a class function may have the same name.
+      kind = info.class.name.split("::").last
+      key = "#{container_name}.#{kind}.#{info.name}"
+      @cache.fetch(:callables, key, &compute)
     end
 
     def define_struct(info, options={})
@@ -123,15 +169,19 @@ module GObjectIntrospection
       define_boxed(info)
     end
 
-    def load_enum_value(value_info, enum_module)
-      enum_module.const_set(value_info.name.upcase, value_info.value)
+    def enum_values(info)
+      @cache.fetch(:enum_values, info.name) do
+        info.values.collect do |value_info|
+          [value_info.name.upcase, value_info.value]
+        end
+      end
     end
 
     def load_enum_info(info)
       if info.gtype == GLib::Type::NONE
         enum_module = Module.new
-        info.values.each do |value_info|
-          load_enum_value(value_info, enum_module)
+        enum_values(info).each do |name, value|
+          enum_module.const_set(name, value)
         end
         @base_module.const_set(info.name, enum_module)
       else
@@ -139,15 +189,11 @@ module GObjectIntrospection
       end
     end
 
-    def load_flag_value(value_info, flags_module)
-      flags_module.const_set(value_info.name.upcase, value_info.value)
-    end
-
     def load_flags_info(info)
       if info.gtype == GLib::Type::NONE
         flags_module = Module.new
-        info.values.each do |value_info|
-          load_flag_value(value_info, flags_module)
+        enum_values(info).each do |name, value|
+          flags_module.const_set(name, value)
         end
         @base_module.const_set(info.name, flags_module)
       else
@@ -162,6 +208,21 @@ module GObjectIntrospection
     end
 
     def load_fields(info, klass)
+      if @lazy
+        enable_lazy_loader(klass)
+        info.n_fields.times do |i|
+          name = info.get_field(i).name
+          LazyLoader.define_stub(klass, name) if Object.method_defined?(name)
+        end
+        LazyLoader.register(klass) do
+          load_fields_without_lazy(info, klass)
+        end
+      else
+        load_fields_without_lazy(info, klass)
+      end
+    end
+
+    def load_fields_without_lazy(info, klass)
       info.n_fields.times do |i|
         field_info = info.get_field(i)
         load_field(info, i, field_info, klass)
@@ -186,6 +247,69 @@ module GObjectIntrospection
     end
 
     def load_methods(info, klass)
+      if @lazy
+        enable_lazy_loader(klass)
+        define_lazy_initialize(klass) if klass.is_a?(Class)
+        define_lazy_stubs(info, klass)
+        LazyLoader.register(klass) do
+          remove_lazy_initialize(klass) if klass.is_a?(Class)
+          load_methods_without_lazy(info, klass)
+        end
+      else
+        load_methods_without_lazy(info, klass)
+      end
+    end
+
+    def enable_lazy_loader(klass)
+      LazyLoader.enable_instance_methods(klass)
+      LazyLoader.enable_singleton_methods(klass)
+    end
+
+    # Methods named like ones of Object or Module, such as to_s or
+    # hash, are never missing. They get stubs.
+    def define_lazy_stubs(info, klass)
+      info.methods.each do |method_info|
+        case method_info
+        when ConstructorInfo
+          next
+        when MethodInfo
+          name = callable_metadata(method_info, klass)[:name]
+          next unless Object.method_defined?(name)
+          LazyLoader.define_stub(klass, name)
+        when FunctionInfo
+          name = callable_metadata(method_info, klass)[:name]
+          next if name == "new" or name == "alloc"
+          next unless singleton_method_defined?(klass, name)
+          LazyLoader.define_singleton_stub(klass, name)
+        end
+      end
+    end
+
+    # respond_to? can't be used because it loads pending definitions.
+    def singleton_method_defined?(target, name)
+      (class << target; self; end).method_defined?(name)
+    end
+
+    LAZY_INITIALIZE = "__gi_lazy_initialize__"
+    def define_lazy_initialize(klass)
+      klass.__send__(:define_method, LAZY_INITIALIZE) do |*arguments, &block|
+        LazyLoader.load_ancestors(self.class)
+        initialize = klass.instance_method(:initialize)
+        initialize.bind(self).call(*arguments, &block)
+      end
+      klass.__send__(:alias_method, "initialize", LAZY_INITIALIZE)
+      klass.__send__(:private, "initialize", LAZY_INITIALIZE)
+    end
+
+    def remove_lazy_initialize(klass)
+      lazy_initialize = klass.instance_method(LAZY_INITIALIZE)
+      if klass.instance_method(:initialize) == lazy_initialize
+        klass.__send__(:remove_method, :initialize)
+      end
+      klass.__send__(:remove_method, LAZY_INITIALIZE)
+    end
+
+    def load_methods_without_lazy(info, klass)
       grouped_methods = info.methods.group_by do |method_info|
         method_info.class
       end
@@ -299,9 +423,10 @@ module GObjectIntrospection
 
     def load_method_infos(infos, klass)
       infos.each do |info|
-        method_name = rubyish_method_name(info)
+        metadata = callable_metadata(info, klass)
+        method_name = metadata[:name]
         load_method_info(info, klass, method_name)
-        if /\Aset_/ =~ method_name and info.n_args == 1
+        if /\Aset_/ =~ method_name and metadata[:n_args] == 1
           klass.__send__(:alias_method, "#{$POSTMATCH}=", method_name)
         end
       end
@@ -309,46 +434,19 @@ module GObjectIntrospection
 
     def load_method_info(info, klass, method_name)
       unlock_gvl = should_unlock_gvl?(info, klass)
-      validate = lambda do |arguments|
-        validate_arguments(info, "#{klass}\##{method_name}", arguments)
-      end
-      klass.__send__(:define_method, method_name) do |*arguments, &block|
-        validate.call(arguments, &block)
-        if block.nil? and info.require_callback?
-          Enumerator.new(self, method_name, *arguments)
-        else
-          info.invoke({
-                        :receiver  => self,
-                        :arguments => arguments,
-                        :unlock_gvl => unlock_gvl,
-                      },
-                      &block)
-        end
-      end
+      self.class.define_method_invoker(info, klass, method_name, unlock_gvl,
+                                       callable_metadata(info, klass))
     end
 
     def load_function_infos(infos, klass)
       infos.each do |info|
-        name = rubyish_method_name(info)
+        metadata = callable_metadata(info, klass)
+        name = metadata[:name]
         next if name == "new"
         next if name == "alloc"
         unlock_gvl = should_unlock_gvl?(info, klass)
-        validate = lambda do |arguments|
-          validate_arguments(info, "#{klass}.#{name}", arguments)
-        end
-        singleton_class = (class << klass; self; end)
-        singleton_class.__send__(:define_method, name) do |*arguments, &block|
-          validate.call(arguments, &block)
-          if block.nil? and info.require_callback?
-            Enumerator.new(self, name, *arguments)
-          else
-            info.invoke({
-                          :arguments => arguments,
-                          :unlock_gvl => unlock_gvl,
-                        },
-                        &block)
-          end
-        end
+        self.class.define_singleton_method_invoker(info, klass, name,
+                                                   unlock_gvl, metadata)
       end
     end
 
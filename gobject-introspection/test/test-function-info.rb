@@ -35,5 +35,27 @@ class TestFunctionInfo < Test::Unit::TestCase
     #assert_equal("notify", @info.invoke(1))
     assert_equal("notify", @info.invoke([1]))
   end
+
+  def test_invoke_positional
+    assert_equal("notify", @info.invoke_positional(1))
+  end
+
+  def test_invoke_positional_too_many_arguments
+    assert_raise(ArgumentError) do
+      @info.invoke_positional(1, 2)
+    end
+  end
+
+  def test_invoke_positional_wrong_type
+    assert_raise(TypeError) do
+      @info.invoke_positional("notify")
+    end
+  end
+
+  def test_invoke_positional_missing_argument
+    assert_raise(TypeError) do
+      @info.invoke_positional
+    end
+  end
 end
 
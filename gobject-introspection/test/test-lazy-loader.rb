@@ -0,0 +1,85 @@
+# Copyright (C) 2013  Ruby-GNOME2 Project Team
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+class TestLazyLoader < Test::Unit::TestCase
+  def setup
+    @class = Class.new
+    @n_loaded = 0
+    GObjectIntrospection::LazyLoader.enable_instance_methods(@class)
+    GObjectIntrospection::LazyLoader.enable_singleton_methods(@class)
+    GObjectIntrospection::LazyLoader.register(@class) do
+      @n_loaded += 1
+      @class.__send__(:define_method, :answer) do
+        42
+      end
+      (class << @class; self; end).__send__(:define_method, :lazy_name) do
+        "lazy"
+      end
+    end
+  end
+
+  def test_instance_method
+    object = @class.new
+    assert_equal([42, 42, 1],
+                 [object.answer, object.answer, @n_loaded])
+  end
+
+  def test_singleton_method
+    assert_equal("lazy", @class.lazy_name)
+  end
+
+  def test_respond_to
+    assert_equal([true, 1],
+                 [@class.new.respond_to?(:answer), @n_loaded])
+  end
+
+  def test_subclass
+    subclass = Class.new(@class)
+    assert_equal([true, 1],
+                 [subclass.method_defined?(:answer), @n_loaded])
+  end
+
+  def test_missing
+    assert_raise(NoMethodError) do
+      @class.new.nonexistent
+    end
+  end
+
+  def test_alias_method
+    @class.__send__(:alias_method, :answer_raw, :answer)
+    assert_equal([42, 1], [@class.new.answer_raw, @n_loaded])
+  end
+
+  def test_override
+    @class.__send__(:define_method, :answer) do
+      "overridden"
+    end
+    assert_equal(["overridden", 1], [@class.new.answer, @n_loaded])
+  end
+
+  def test_stub
+    loaded_class = @class
+    GObjectIntrospection::LazyLoader.register(@class) do
+      loaded_class.__send__(:define_method, :to_s) do
+        "loaded"
+      end
+    end
+    GObjectIntrospection::LazyLoader.running do
+      GObjectIntrospection::LazyLoader.define_stub(@class, :to_s)
+    end
+    assert_equal(["loaded", 1], [@class.new.to_s, @n_loaded])
+  end
+end
@@ -0,0 +1,134 @@
+# Copyright (C) 2013  Ruby-GNOME2 Project Team
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+require "tmpdir"
+
+class TestLoaderCache < Test::Unit::TestCase
+  def setup
+    @directory = Dir.mktmpdir
+    @path = File.join(@directory, "GObject-2.0.cache")
+  end
+
+  def teardown
+    FileUtils.rm_rf(@directory)
+  end
+
+  def test_fetch
+    cache = GObjectIntrospection::LoaderCache.new(@path, ["key"])
+    assert_equal([1, 1],
+                 [cache.fetch(:callables, "x") {1},
+                  cache.fetch(:callables, "x") {2}])
+  end
+
+  def test_save
+    cache = GObjectIntrospection::LoaderCache.new(@path, ["key"])
+    cache.fetch(:callables, "x") {1}
+    cache.save
+    cache = GObjectIntrospection::LoaderCache.new(@path, ["key"])
+    assert_equal(1, cache.fetch(:callables, "x") {2})
+  end
+
+  def test_key_changed
+    cache = GObjectIntrospection::LoaderCache.new(@path, ["key"])
+    cache.fetch(:callables, "x") {1}
+    cache.save
+    cache = GObjectIntrospection::LoaderCache.new(@path, ["new-key"])
+    assert_equal(2, cache.fetch(:callables, "x") {2})
+  end
+
+  def test_symbol_keys
+    cache = GObjectIntrospection::LoaderCache.new(@path, ["key"])
+    cache.fetch(:callables, "x") {{:name => "x", :n_args => 1}}
+    cache.save
+    cache = GObjectIntrospection::LoaderCache.new(@path, ["key"])
+    assert_equal({:name => "x", :n_args => 1},
+                 cache.fetch(:callables, "x") {{}})
+  end
+
+  def test_broken_file
+    File.open(@path, "wb") do |file|
+      file.write(Marshal.dump([["key"], {:callables => {"x" => 1}}]))
+    end
+    cache = GObjectIntrospection::LoaderCache.new(@path, ["key"])
+    assert_equal(2, cache.fetch(:callables, "x") {2})
+  end
+
+  class TestOpen < self
+    def setup
+      super
+      @repository = GObjectIntrospection::Repository.default
+      @repository.require("GObject")
+      GObjectIntrospection::LoaderCache.directory = @directory
+    end
+
+    def teardown
+      GObjectIntrospection::LoaderCache.directory = nil
+      super
+    end
+
+    def compute_code_digest(loader_class)
+      GObjectIntrospection::LoaderCache.__send__(:compute_code_digest,
+                                                 loader_class)
+    end
+
+    def open_cache
+      GObjectIntrospection::LoaderCache.open(GObjectIntrospection::Loader,
+                                             @repository,
+                                             "GObject")
+    end
+
+    def test_path
+      assert_equal(@directory, File.dirname(open_cache.path))
+    end
+
+    def test_save
+      cache = open_cache
+      cache.fetch(:enum_values, "SignalFlags") {[["RUN_FIRST", 1]]}
+      cache.save
+      assert_equal([["RUN_FIRST", 1]],
+                   open_cache.fetch(:enum_values, "SignalFlags") {[]})
+    end
+
+    def test_code_digest
+      loader_path = File.join(@directory, "custom-loader.rb")
+      write_loader = lambda do |prefix|
+        File.open(loader_path, "w") do |file|
+          file.puts(<<-RUBY)
+class TestLoaderCacheCustomLoader < GObjectIntrospection::Loader
+  def rubyish_method_name(function_info)
+    "#{prefix}\#{super}"
+  end
+end
+          RUBY
+        end
+        load(loader_path)
+      end
+
+      write_loader.call("custom_")
+      digest = compute_code_digest(TestLoaderCacheCustomLoader)
+      assert_not_equal(compute_code_digest(GObjectIntrospection::Loader),
+                       digest)
+      write_loader.call("changed_")
+      assert_not_equal(digest,
+                       compute_code_digest(TestLoaderCacheCustomLoader))
+    end
+
+    def test_disabled
+      GObjectIntrospection::LoaderCache.directory = nil
+      assert_nil(open_cache.path)
+    end
+  end
+end
@@ -27,4 +27,42 @@ class TestLoaderInfo < Test::Unit::TestCase
     GObjectIntrospection::Loader.define_class(gtype, "Application", @sandbox)
     assert_equal(gtype, @sandbox::Application.gtype)
   end
+
+  def test_define_module_function_invoker
+    info = find_signal_name_info
+    GObjectIntrospection::Loader.define_module_function_invoker(info,
+                                                                @sandbox,
+                                                                "signal_name",
+                                                                false)
+    assert_equal("notify", @sandbox.signal_name(1))
+  end
+
+  def test_define_module_function_invoker_wrong_number_of_arguments
+    info = find_signal_name_info
+    GObjectIntrospection::Loader.define_module_function_invoker(info,
+                                                                @sandbox,
+                                                                "signal_name",
+                                                                false)
+    assert_raise(ArgumentError) do
+      @sandbox.signal_name
+    end
+  end
+
+  def test_define_module_function_invoker_wrong_type
+    info = find_signal_name_info
+    GObjectIntrospection::Loader.define_module_function_invoker(info,
+                                                                @sandbox,
+                                                                "signal_name",
+                                                                false)
+    assert_raise(TypeError) do
+      @sandbox.signal_name("notify")
+    end
+    assert_equal("notify", @sandbox.signal_name(1))
+  end
+
+  private
+  def find_signal_name_info
+    @repository.require("GObject")
+    @repository.find("GObject", "signal_name")
+  end
 end
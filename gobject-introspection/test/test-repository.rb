@@ -35,6 +35,15 @@ class TestRepository < Test::Unit::TestCase
                  @repository.get_dependencies("Gio").sort)
   end
 
+  def test_get_version
+    assert_equal("2.0", @repository.get_version("GObject"))
+  end
+
+  def test_get_typelib_path
+    assert_match(/GObject-2\.0\.typelib\z/,
+                 @repository.get_typelib_path("GObject"))
+  end
+
   def test_loaded_namespaces
     assert_equal(["GLib", "GObject", "Gio"].sort,
                  @repository.loaded_namespaces.sort)
@@ -0,0 +1,249 @@
+/* -*- c-file-style: "ruby"; indent-tabs-mode: nil -*- */
+/*
+ *  Copyright (C) 2013  Ruby-GNOME2 Project Team
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+#include "rbgst.h"
+
+#define RG_TARGET_NAMESPACE cBuffer
+
+#define SELF(object) ((GstBuffer *)RVAL2BOXED(object, GST_TYPE_BUFFER))
+
+static VALUE cBufferView;
+
+/*
+ * Gst::BufferView gives access to the memory of a mapped GstBuffer
+ * without copying it into a Ruby String. A view is only valid inside
+ * the Gst::Buffer#map block; the buffer is unmapped when the block
+ * exits and the view raises on any access after that.
+ */
+typedef struct {
+    GstBuffer *buffer;
+    GstMapInfo info;
+    gboolean mapped;
+} BufferView;
+
+static void
+buffer_view_unmap(BufferView *view)
+{
+    if (!view->mapped)
+        return;
+
+    gst_buffer_unmap(view->buffer, &(view->info));
+    gst_buffer_unref(view->buffer);
+    view->buffer = NULL;
+    view->mapped = FALSE;
+}
+
+static void
+buffer_view_free(BufferView *view)
+{
+    buffer_view_unmap(view);
+    xfree(view);
+}
+
+static BufferView *
+buffer_view_get(VALUE self)
+{
+    BufferView *view;
+
+    Data_Get_Struct(self, BufferView, view);
+    if (!view->mapped)
+        rb_raise(rb_eRuntimeError, "buffer is already unmapped");
+    return view;
+}
+
+static void
+buffer_view_check_range(BufferView *view, long offset, long length)
+{
+    if (offset < 0 || length < 0 ||
+        (gsize)offset > view->info.size ||
+        (gsize)length > view->info.size - (gsize)offset)
+        rb_raise(rb_eIndexError,
+                 "out of mapped range: offset: %ld, length: %ld, size: %"
+                 G_GSIZE_FORMAT,
+                 offset, length, view->info.size);
+}
+
+static VALUE
+rg_view_size(VALUE self)
+{
+    return ULL2NUM((unsigned LONG_LONG)buffer_view_get(self)->info.size);
+}
+
+static VALUE
+rg_view_address(VALUE self)
+{
+    return ULL2NUM((unsigned LONG_LONG)(guintptr)buffer_view_get(self)->info.data);
+}
+
+static VALUE
+rg_view_readable_p(VALUE self)
+{
+    return CBOOL2RVAL(buffer_view_get(self)->info.flags & GST_MAP_READ);
+}
+
+static VALUE
+rg_view_writable_p(VALUE self)
+{
+    return CBOOL2RVAL(buffer_view_get(self)->info.flags & GST_MAP_WRITE);
+}
+
+static VALUE
+rg_view_mapped_p(VALUE self)
+{
+    BufferView *view;
+
+    Data_Get_Struct(self, BufferView, view);
+    return CBOOL2RVAL(view->mapped);
+}
+
+static VALUE
+rg_view_get_byte(VALUE self, VALUE rb_offset)
+{
+    BufferView *view = buffer_view_get(self);
+    long offset = NUM2LONG(rb_offset);
+
+    buffer_view_check_range(view, offset, 1);
+    return INT2FIX(view->info.data[offset]);
+}
+
+static VALUE
+rg_view_set_byte(VALUE self, VALUE rb_offset, VALUE rb_byte)
+{
+    BufferView *view = buffer_view_get(self);
+    long offset = NUM2LONG(rb_offset);
+
+    if (!(view->info.flags & GST_MAP_WRITE))
+        rb_raise(rb_eIOError, "buffer isn't mapped for writing");
+    buffer_view_check_range(view, offset, 1);
+    view->info.data[offset] = (guint8)NUM2UINT(rb_byte);
+    return rb_byte;
+}
+
+/*
+ * Copies length bytes from offset, or everything from offset when
+ * length is omitted, into a new binary String. This is the copying
+ * path; pass #address to native code to use the memory in place.
+ */
+static VALUE
+rg_view_get_bytes(int argc, VALUE *argv, VALUE self)
+{
+    BufferView *view = buffer_view_get(self);
+    VALUE rb_offset, rb_length;
+    long offset, length;
+
+    rb_scan_args(argc, argv, "02", &rb_offset, &rb_length);
+    offset = NIL_P(rb_offset) ? 0 : NUM2LONG(rb_offset);
+    if (NIL_P(rb_length)) {
+        length = (long)view->info.size - offset;
+    } else {
+        length = NUM2LONG(rb_length);
+    }
+    buffer_view_check_range(view, offset, length);
+
+    return rb_str_new((const char *)(view->info.data + offset), length);
+}
+
+static VALUE
+rg_view_set_bytes(VALUE self, VALUE rb_offset, VALUE rb_bytes)
+{
+    BufferView *view = buffer_view_get(self);
+    long offset = NUM2LONG(rb_offset);
+
+    StringValue(rb_bytes);
+    if (!(view->info.flags & GST_MAP_WRITE))
+        rb_raise(rb_eIOError, "buffer isn't mapped for writing");
+    buffer_view_check_range(view, offset, RSTRING_LEN(rb_bytes));
+    memcpy(view->info.data + offset,
+           RSTRING_PTR(rb_bytes),
+           RSTRING_LEN(rb_bytes));
+    return self;
+}
+
+/**********************************************************************/
+
+static VALUE
+buffer_map_ensure(VALUE rb_view)
+{
+    BufferView *view;
+
+    Data_Get_Struct(rb_view, BufferView, view);
+    buffer_view_unmap(view);
+    return Qnil;
+}
+
+/*
+ * Gst::Buffer#map(flags=Gst::MapFlags::READ) {|view| ...}
+ *
+ * Maps the buffer and yields a Gst::BufferView of its memory. The
+ * buffer is unmapped when the block exits. Returns the value of the
+ * block.
+ */
+static VALUE
+rg_map(int argc, VALUE *argv, VALUE self)
+{
+    VALUE rb_flags, rb_view;
+    BufferView *view;
+    GstMapFlags flags;
+    GstBuffer *buffer;
+
+    rb_scan_args(argc, argv, "01", &rb_flags);
+    if (NIL_P(rb_flags)) {
+        flags = GST_MAP_READ;
+    } else {
+        flags = RVAL2GFLAGS(rb_flags, GST_TYPE_MAP_FLAGS);
+    }
+
+    buffer = SELF(self);
+    if ((flags & GST_MAP_WRITE) && !gst_buffer_is_writable(buffer))
+        rb_raise(rb_eIOError, "failed to map buffer: not writable");
+    rb_view = Data_Make_Struct(cBufferView, BufferView,
+                               NULL, buffer_view_free, view);
+    if (!gst_buffer_map(buffer, &(view->info), flags))
+        rb_raise(rb_eIOError, "failed to map buffer");
+    view->buffer = gst_buffer_ref(buffer);
+    view->mapped = TRUE;
+
+    return rb_ensure(rb_yield, rb_view, buffer_map_ensure, rb_view);
+}
+
+void
+rb_gst_init_buffer(void)
+{
+    VALUE mGst;
+    VALUE RG_TARGET_NAMESPACE;
+
+    mGst = rb_const_get(rb_cObject, rb_intern("Gst"));
+    RG_TARGET_NAMESPACE = rb_const_get(mGst, rb_intern("Buffer"));
+
+    RG_DEF_METHOD(map, -1);
+
+    cBufferView = rb_define_class_under(mGst, "BufferView", rb_cObject);
+    rb_undef_alloc_func(cBufferView);
+    rbg_define_method(cBufferView, "size", rg_view_size, 0);
+    rbg_define_method(cBufferView, "address", rg_view_address, 0);
+    rbg_define_method(cBufferView, "to_i", rg_view_address, 0);
+    rbg_define_method(cBufferView, "readable?", rg_view_readable_p, 0);
+    rbg_define_method(cBufferView, "writable?", rg_view_writable_p, 0);
+    rbg_define_method(cBufferView, "mapped?", rg_view_mapped_p, 0);
+    rbg_define_method(cBufferView, "[]", rg_view_get_byte, 1);
+    rbg_define_method(cBufferView, "[]=", rg_view_set_byte, 2);
+    rbg_define_method(cBufferView, "get_bytes", rg_view_get_bytes, -1);
+    rbg_define_method(cBufferView, "set_bytes", rg_view_set_bytes, 2);
+}
@@ -0,0 +1,455 @@
+/* -*- c-file-style: "ruby"; indent-tabs-mode: nil -*- */
+/*
+ *  Copyright (C) 2013  Ruby-GNOME2 Project Team
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+#include "rbgst.h"
+
+#define RG_TARGET_NAMESPACE cBus
+
+#define SELF(object) (GST_BUS(RVAL2GOBJ(object)))
+
+static ID id_call;
+
+/*
+ * Messages are matched against a GstMessageType mask and an optional
+ * source object before anything is converted to Ruby objects, so
+ * uninteresting messages never enter Ruby.
+ */
+typedef struct {
+    GstMessageType types;
+    GstObject *source;
+} MessageFilter;
+
+static void
+message_filter_init(MessageFilter *filter, VALUE rb_types, VALUE rb_source)
+{
+    filter->types = RVAL2GFLAGS(rb_types, GST_TYPE_MESSAGE_TYPE);
+    if (NIL_P(rb_source)) {
+        filter->source = NULL;
+    } else {
+        filter->source = gst_object_ref(GST_OBJECT(RVAL2GOBJ(rb_source)));
+    }
+}
+
+static void
+message_filter_clear(MessageFilter *filter)
+{
+    if (filter->source) {
+        gst_object_unref(filter->source);
+        filter->source = NULL;
+    }
+}
+
+static gboolean
+message_filter_match(MessageFilter *filter, GstMessage *message)
+{
+    if (!(GST_MESSAGE_TYPE(message) & filter->types))
+        return FALSE;
+    if (filter->source && GST_MESSAGE_SRC(message) != filter->source)
+        return FALSE;
+    return TRUE;
+}
+
+/**********************************************************************/
+
+typedef struct {
+    GstBus *bus;
+    VALUE rb_callback;
+    MessageFilter filter;
+    gboolean batch;
+    guint max_batch_size;
+    gint priority;
+    guint source_id;
+    GPtrArray *messages;
+    guint flush_id;
+    gboolean flushing;
+    gboolean removed;
+} FilteredWatch;
+
+typedef struct {
+    FilteredWatch *watch;
+    GstMessage *message;
+} FilteredWatchCallArgs;
+
+static void
+filtered_watch_clear_messages(FilteredWatch *watch)
+{
+    guint i;
+
+    for (i = 0; i < watch->messages->len; i++) {
+        gst_message_unref(g_ptr_array_index(watch->messages, i));
+    }
+    g_ptr_array_set_size(watch->messages, 0);
+}
+
+static void
+filtered_watch_free(FilteredWatch *watch)
+{
+    filtered_watch_clear_messages(watch);
+    g_ptr_array_free(watch->messages, TRUE);
+    message_filter_clear(&(watch->filter));
+    g_free(watch);
+}
+
+static void
+filtered_watch_destroy(gpointer data)
+{
+    FilteredWatch *watch = data;
+
+    G_CHILD_REMOVE(GOBJ2RVAL(watch->bus), watch->rb_callback);
+    if (watch->flush_id > 0) {
+        g_source_remove(watch->flush_id);
+        watch->flush_id = 0;
+    }
+    watch->removed = TRUE;
+    /* The running flush frees the watch after the callback returns. */
+    if (!watch->flushing)
+        filtered_watch_free(watch);
+}
+
+static VALUE
+filtered_watch_call(VALUE data)
+{
+    FilteredWatchCallArgs *args = (FilteredWatchCallArgs *)data;
+    FilteredWatch *watch = args->watch;
+
+    return rb_funcall(watch->rb_callback, id_call, 2,
+                      GOBJ2RVAL(watch->bus),
+                      BOXED2RVAL(args->message,
+                                 GST_MINI_OBJECT_TYPE(args->message)));
+}
+
+static VALUE
+filtered_watch_flush_call(VALUE data)
+{
+    FilteredWatch *watch = (FilteredWatch *)data;
+    VALUE rb_messages;
+    guint i;
+
+    rb_messages = rb_ary_new2(watch->messages->len);
+    for (i = 0; i < watch->messages->len; i++) {
+        GstMessage *message = g_ptr_array_index(watch->messages, i);
+        rb_ary_push(rb_messages,
+                    BOXED2RVAL(message, GST_MINI_OBJECT_TYPE(message)));
+    }
+    filtered_watch_clear_messages(watch);
+
+    return rb_funcall(watch->rb_callback, id_call, 2,
+                      GOBJ2RVAL(watch->bus), rb_messages);
+}
+
+static gboolean
+filtered_watch_flush_messages(FilteredWatch *watch)
+{
+    VALUE rb_keep;
+
+    watch->flushing = TRUE;
+    rb_keep = G_PROTECT_CALLBACK(filtered_watch_flush_call, watch);
+    watch->flushing = FALSE;
+
+    return RVAL2CBOOL(rb_keep);
+}
+
+static gboolean
+filtered_watch_flush(gpointer data)
+{
+    FilteredWatch *watch = data;
+    gboolean keep;
+
+    watch->flush_id = 0;
+    keep = filtered_watch_flush_messages(watch);
+
+    if (watch->removed) {
+        filtered_watch_free(watch);
+    } else if (!keep) {
+        g_source_remove(watch->source_id);
+    }
+
+    return FALSE;
+}
+
+static gboolean
+filtered_watch_func(G_GNUC_UNUSED GstBus *bus, GstMessage *message,
+                    gpointer user_data)
+{
+    FilteredWatch *watch = user_data;
+    FilteredWatchCallArgs args;
+    VALUE rb_keep;
+
+    if (!message_filter_match(&(watch->filter), message))
+        return TRUE;
+
+    if (watch->batch) {
+        g_ptr_array_add(watch->messages, gst_message_ref(message));
+        if (watch->messages->len >= watch->max_batch_size) {
+            /* The idle flush never runs while messages keep coming
+             * in, so a full batch is delivered from the watch. GLib
+             * keeps the watch alive until this dispatch returns. */
+            if (watch->flush_id > 0) {
+                g_source_remove(watch->flush_id);
+                watch->flush_id = 0;
+            }
+            return filtered_watch_flush_messages(watch);
+        }
+        if (watch->flush_id == 0) {
+            /* Lower priority than the watch: the batch is delivered
+             * once the bus is drained in this main loop iteration. */
+            watch->flush_id = g_idle_add_full(watch->priority + 1,
+                                              filtered_watch_flush,
+                                              watch,
+                                              NULL);
+        }
+        return TRUE;
+    }
+
+    args.watch = watch;
+    args.message = message;
+    rb_keep = G_PROTECT_CALLBACK(filtered_watch_call, &args);
+    return RVAL2CBOOL(rb_keep);
+}
+
+static VALUE
+rg_add_filtered_watch_raw(VALUE self, VALUE rb_types, VALUE rb_source,
+                          VALUE rb_priority, VALUE rb_batch,
+                          VALUE rb_max_batch_size)
+{
+    FilteredWatch *watch;
+    GSource *source;
+
+    watch = g_new0(FilteredWatch, 1);
+    watch->bus = SELF(self);
+    watch->rb_callback = rb_block_proc();
+    watch->batch = RVAL2CBOOL(rb_batch);
+    watch->max_batch_size = MAX(NUM2UINT(rb_max_batch_size), 1);
+    watch->priority = NUM2INT(rb_priority);
+    watch->messages = g_ptr_array_new();
+    message_filter_init(&(watch->filter), rb_types, rb_source);
+    G_CHILD_ADD(self, watch->rb_callback);
+
+    source = gst_bus_create_watch(watch->bus);
+    g_source_set_priority(source, watch->priority);
+    g_source_set_callback(source,
+                          (GSourceFunc)filtered_watch_func,
+                          watch,
+                          filtered_watch_destroy);
+    watch->source_id = g_source_attach(source, NULL);
+    g_source_unref(source);
+
+    return UINT2NUM(watch->source_id);
+}
+
+/**********************************************************************/
+
+typedef struct {
+    VALUE rb_callback;
+    MessageFilter filter;
+} FilteredSyncHandler;
+
+typedef struct {
+    FilteredSyncHandler *handler;
+    GstBus *bus;
+    GstMessage *message;
+} FilteredSyncHandlerCallArgs;
+
+static VALUE
+filtered_sync_handler_call(VALUE data)
+{
+    FilteredSyncHandlerCallArgs *args = (FilteredSyncHandlerCallArgs *)data;
+    FilteredSyncHandler *handler = args->handler;
+    VALUE rb_reply;
+
+    rb_reply = rb_funcall(handler->rb_callback, id_call, 2,
+                          GOBJ2RVAL(args->bus),
+                          BOXED2RVAL(args->message,
+                                     GST_MINI_OBJECT_TYPE(args->message)));
+    return INT2NUM(RVAL2GENUM(rb_reply, GST_TYPE_BUS_SYNC_REPLY));
+}
+
+static GstBusSyncReply
+filtered_sync_handler_func(GstBus *bus, GstMessage *message,
+                           gpointer user_data)
+{
+    FilteredSyncHandler *handler = user_data;
+    FilteredSyncHandlerCallArgs args;
+    VALUE rb_reply;
+
+    if (!message_filter_match(&(handler->filter), message))
+        return GST_BUS_PASS;
+
+    args.handler = handler;
+    args.bus = bus;
+    args.message = message;
+    rb_reply = G_PROTECT_CALLBACK(filtered_sync_handler_call, &args);
+    if (NIL_P(rb_reply))
+        return GST_BUS_DROP;
+    return NUM2INT(rb_reply);
+}
+
+static void
+filtered_sync_handler_free(gpointer data)
+{
+    FilteredSyncHandler *handler = data;
+
+    message_filter_clear(&(handler->filter));
+    g_free(handler);
+}
+
+static VALUE
+rg_set_filtered_sync_handler(VALUE self, VALUE rb_types, VALUE rb_source)
+{
+    FilteredSyncHandler *handler;
+    ID id_sync_handler;
+
+    CONST_ID(id_sync_handler, "sync_handler");
+
+    handler = g_new0(FilteredSyncHandler, 1);
+    handler->rb_callback = rb_block_proc();
+    message_filter_init(&(handler->filter), rb_types, rb_source);
+    G_CHILD_SET(self, id_sync_handler, handler->rb_callback);
+
+    gst_bus_set_sync_handler(SELF(self),
+                             filtered_sync_handler_func,
+                             handler,
+                             filtered_sync_handler_free);
+
+    return self;
+}
+
+/**********************************************************************/
+
+/*
+ * Fire-and-forget sync handler: streaming threads queue the matching
+ * messages and get the reply right away without waiting for Ruby. The
+ * block is called for the queued messages on a Ruby thread later.
+ */
+typedef struct {
+    VALUE rb_callback;
+    MessageFilter filter;
+    GstBusSyncReply reply;
+    RBGUtilAsyncCallback *callback;
+} AsyncSyncHandler;
+
+typedef struct {
+    AsyncSyncHandler *handler;
+    GstBus *bus;
+    GstMessage *message;
+} AsyncSyncHandlerMessage;
+
+static VALUE
+async_sync_handler_call(VALUE data)
+{
+    AsyncSyncHandlerMessage *queued = (AsyncSyncHandlerMessage *)data;
+
+    return rb_funcall(queued->handler->rb_callback, id_call, 2,
+                      GOBJ2RVAL(queued->bus),
+                      BOXED2RVAL(queued->message,
+                                 GST_MINI_OBJECT_TYPE(queued->message)));
+}
+
+static void
+async_sync_handler_message_free(gpointer data)
+{
+    AsyncSyncHandlerMessage *queued = data;
+
+    gst_message_unref(queued->message);
+    gst_object_unref(queued->bus);
+    g_free(queued);
+}
+
+static GstBusSyncReply
+async_sync_handler_func(GstBus *bus, GstMessage *message, gpointer user_data)
+{
+    AsyncSyncHandler *handler = user_data;
+    AsyncSyncHandlerMessage *queued;
+    GstBusSyncReply reply;
+
+    if (!message_filter_match(&(handler->filter), message))
+        return GST_BUS_PASS;
+
+    reply = handler->reply;
+    queued = g_new(AsyncSyncHandlerMessage, 1);
+    queued->handler = handler;
+    queued->bus = gst_object_ref(bus);
+    queued->message = gst_message_ref(message);
+    rbgutil_async_callback_invoke(handler->callback, queued);
+    return reply;
+}
+
+/* Called on a Ruby thread once the queued messages are delivered. */
+static void
+async_sync_handler_finalize(gpointer data)
+{
+    AsyncSyncHandler *handler = data;
+
+    rb_gc_unregister_address(&(handler->rb_callback));
+    message_filter_clear(&(handler->filter));
+    g_free(handler);
+}
+
+static void
+async_sync_handler_free(gpointer data)
+{
+    AsyncSyncHandler *handler = data;
+
+    rbgutil_async_callback_free(handler->callback);
+}
+
+static VALUE
+rg_set_async_sync_handler_raw(VALUE self, VALUE rb_types, VALUE rb_source,
+                              VALUE rb_reply, VALUE rb_max_queued)
+{
+    AsyncSyncHandler *handler;
+
+    handler = g_new0(AsyncSyncHandler, 1);
+    handler->rb_callback = rb_block_proc();
+    rb_gc_register_address(&(handler->rb_callback));
+    message_filter_init(&(handler->filter), rb_types, rb_source);
+    handler->reply = RVAL2GENUM(rb_reply, GST_TYPE_BUS_SYNC_REPLY);
+    handler->callback =
+        rbgutil_async_callback_new(async_sync_handler_call,
+                                   async_sync_handler_message_free,
+                                   NUM2UINT(rb_max_queued),
+                                   RBGUTIL_CALLBACK_OVERFLOW_DROP);
+    rbgutil_async_callback_set_finalize_func(handler->callback,
+                                             async_sync_handler_finalize,
+                                             handler);
+
+    gst_bus_set_sync_handler(SELF(self),
+                             async_sync_handler_func,
+                             handler,
+                             async_sync_handler_free);
+
+    return self;
+}
+
+void
+rb_gst_init_bus(void)
+{
+    VALUE mGst;
+    VALUE RG_TARGET_NAMESPACE;
+
+    id_call = rb_intern("call");
+
+    mGst = rb_const_get(rb_cObject, rb_intern("Gst"));
+    RG_TARGET_NAMESPACE = rb_const_get(mGst, rb_intern("Bus"));
+
+    RG_DEF_METHOD(add_filtered_watch_raw, 5);
+    RG_DEF_METHOD(set_filtered_sync_handler, 2);
+    RG_DEF_METHOD(set_async_sync_handler_raw, 4);
+}
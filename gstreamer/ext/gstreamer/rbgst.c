@@ -181,4 +181,6 @@ Init_gstreamer (void)
     rbgobj_register_g2r_func(GST_TYPE_LIST, rg_gst_value_list_g2r);
 
     rb_gst_init_element_factory();
+    rb_gst_init_bus();
+    rb_gst_init_buffer();
 }
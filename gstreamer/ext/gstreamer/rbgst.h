@@ -24,3 +24,5 @@
 
 extern void Init_gstreamer (void);
 G_GNUC_INTERNAL extern void rb_gst_init_element_factory (void);
+G_GNUC_INTERNAL extern void rb_gst_init_bus (void);
+G_GNUC_INTERNAL extern void rb_gst_init_buffer (void);
@@ -21,7 +21,39 @@ module Gst
       add_watch_full(priority, &block)
     end
 
-    def sync_handler(&block)
+    # Options:
+    #   :types    - Gst::MessageType to receive (default: ANY)
+    #   :source   - receive only messages posted by this object
+    #   :priority - watch priority (default: GLib::PRIORITY_DEFAULT)
+    #   :batch    - yield an Array of the messages accumulated in a main
+    #               loop iteration instead of each message
+    #   :max_batch_size - yield a batch as soon as it has this many
+    #               messages even if more are pending (default: 64)
+    #
+    # Messages that don't match are skipped without entering Ruby.
+    def add_filtered_watch(options={}, &block)
+      types = options[:types] || MessageType::ANY
+      priority = options[:priority] || GLib::PRIORITY_DEFAULT
+      add_filtered_watch_raw(types, options[:source], priority,
+                             options[:batch] || false,
+                             options[:max_batch_size] || 64,
+                             &block)
+    end
+
+    # Same as add_filtered_watch with :batch => true.
+    def add_batched_watch(options={}, &block)
+      add_filtered_watch(options.merge(:batch => true), &block)
+    end
+
+    # Accepts :types and :source like add_filtered_watch. Messages that
+    # don't match are passed without entering Ruby.
+    #
+    # With :async => true the posting thread doesn't wait for the block:
+    # the message is queued, :reply (default: BusSyncReply::PASS) is
+    # returned right away and the block is called later on a Ruby
+    # thread. Its return value is ignored. At most :max_queued (default:
+    # 256) messages wait for the block; newer ones are dropped.
+    def sync_handler(options={}, &block)
       @sync_handler = lambda do |bus, message|
         begin
           block.call(bus, message)
@@ -33,8 +65,21 @@ module Gst
           BusSyncReply::DROP
         end
       end
-      set_sync_handler(&@sync_handler)
+      if options[:async]
+        types = options[:types] || MessageType::ANY
+        set_async_sync_handler_raw(types, options[:source],
+                                   options[:reply] || BusSyncReply::PASS,
+                                   options[:max_queued] || 256,
+                                   &@sync_handler)
+      elsif options.has_key?(:types) or options.has_key?(:source)
+        types = options[:types] || MessageType::ANY
+        set_filtered_sync_handler(types, options[:source], &@sync_handler)
+      else
+        set_sync_handler(&@sync_handler)
+      end
     end
     private :set_sync_handler
+    private :add_filtered_watch_raw, :set_filtered_sync_handler
+    private :set_async_sync_handler_raw
   end
 end
@@ -0,0 +1,92 @@
+# Copyright (C) 2013  Ruby-GNOME2 Project Team
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+class TestBuffer < Test::Unit::TestCase
+  def setup
+    @buffer = Gst::Buffer.new_allocate(nil, 4, nil)
+  end
+
+  def test_map_address
+    @buffer.map do |view|
+      assert_operator(view.address, :>, 0)
+    end
+  end
+
+  def test_map_out_of_range
+    @buffer.map do |view|
+      assert_raise(IndexError) do
+        view.get_bytes(2, (2 ** (0.size * 8 - 1)) - 2)
+      end
+    end
+  end
+
+  def test_map_write_byte
+    @buffer.map(Gst::MapFlags::WRITE) do |view|
+      view[1] = 0xff
+      assert_equal(0xff, view[1])
+    end
+  end
+
+  def test_map_write_bytes
+    @buffer.map(Gst::MapFlags::WRITE) do |view|
+      view.set_bytes(0, "abcd")
+      view.set_bytes(1, "XY")
+    end
+    @buffer.map do |view|
+      assert_equal(["aXYd", "XY", "Yd"],
+                   [view.get_bytes, view.get_bytes(1, 2), view.get_bytes(2)])
+    end
+  end
+
+  def test_map_view_after_block
+    view = @buffer.map do |mapped_view|
+      mapped_view
+    end
+    assert_false(view.mapped?)
+    assert_raise(RuntimeError) do
+      view.get_bytes
+    end
+  end
+
+  def test_map_write_not_writable
+    @buffer.map do
+      # The read mapping holds a reference to the buffer.
+      assert_raise(IOError) do
+        @buffer.map(Gst::MapFlags::WRITE) do
+        end
+      end
+    end
+  end
+
+  def test_map_read_only_set_byte
+    @buffer.map do |view|
+      assert_raise(IOError) do
+        view[0] = 1
+      end
+    end
+  end
+
+  def test_map_flags
+    read_write = Gst::MapFlags::READ | Gst::MapFlags::WRITE
+    modes = [Gst::MapFlags::READ, Gst::MapFlags::WRITE, read_write]
+    flags = modes.collect do |mode|
+      @buffer.map(mode) do |view|
+        [view.readable?, view.writable?]
+      end
+    end
+    assert_equal([[true, false], [false, true], [true, true]], flags)
+  end
+end
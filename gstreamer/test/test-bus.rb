@@ -0,0 +1,131 @@
+# Copyright (C) 2013  Ruby-GNOME2 Project Team
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+require "thread"
+require "timeout"
+
+class TestBus < Test::Unit::TestCase
+  def test_add_batched_watch_max_batch_size
+    bus = Gst::Bus.new
+    sizes = []
+    bus.add_batched_watch(:max_batch_size => 2) do |_, messages|
+      sizes << messages.size
+      true
+    end
+    5.times do
+      bus.post(Gst::Message.new_eos(nil))
+    end
+    context = GLib::MainContext.default
+    100.times do
+      break if sizes.inject(0, :+) == 5
+      context.iteration(false)
+    end
+    assert_equal([2, 2, 1], sizes)
+  end
+
+  def test_add_filtered_watch_types
+    bus = Gst::Bus.new
+    types = []
+    bus.add_filtered_watch(:types => Gst::MessageType::EOS) do |_, message|
+      types << message.type
+      true
+    end
+    bus.post(Gst::Message.new_latency(nil))
+    bus.post(Gst::Message.new_eos(nil))
+    bus.post(Gst::Message.new_latency(nil))
+    bus.post(Gst::Message.new_eos(nil))
+    iterate_until {types.size == 2}
+    assert_equal([Gst::MessageType::EOS, Gst::MessageType::EOS], types)
+  end
+
+  def test_add_filtered_watch_source
+    bus = Gst::Bus.new
+    source = Gst::ElementFactory.make("fakesrc")
+    other_source = Gst::ElementFactory.make("fakesrc")
+    sources = []
+    bus.add_filtered_watch(:source => source) do |_, message|
+      sources << message.src
+      true
+    end
+    bus.post(Gst::Message.new_eos(other_source))
+    bus.post(Gst::Message.new_eos(source))
+    bus.post(Gst::Message.new_eos(nil))
+    bus.post(Gst::Message.new_eos(source))
+    iterate_until {sources.size == 2}
+    assert_equal([source, source], sources)
+  end
+
+  def test_sync_handler_async_ruby_thread
+    bus = Gst::Bus.new
+    types = []
+    bus.sync_handler(:async => true,
+                     :reply => Gst::BusSyncReply::DROP) do |_, message|
+      types << message.type
+    end
+    bus.post(Gst::Message.new_eos(nil))
+    assert_equal([[Gst::MessageType::EOS], nil],
+                 [types, bus.pop])
+  end
+
+  def test_sync_handler_async_streaming_thread
+    pipeline = Gst::Pipeline.new("pipeline")
+    source = Gst::ElementFactory.make("fakesrc")
+    source.num_buffers = 1
+    sink = Gst::ElementFactory.make("fakesink")
+    pipeline.add(source)
+    pipeline.add(sink)
+    source >> sink
+
+    threads = Queue.new
+    pipeline.bus.sync_handler(:async => true,
+                              :types => Gst::MessageType::EOS) do
+      threads << Thread.current
+    end
+    pipeline.play
+    begin
+      thread = Timeout.timeout(5) do
+        threads.pop
+      end
+    ensure
+      pipeline.stop
+    end
+    assert_not_equal(Thread.current, thread)
+  end
+
+  def test_sync_handler_async_filtered
+    bus = Gst::Bus.new
+    types = []
+    bus.sync_handler(:async => true,
+                     :types => Gst::MessageType::ERROR) do |_, message|
+      types << message.type
+    end
+    bus.post(Gst::Message.new_eos(nil))
+    assert_equal([[], Gst::MessageType::EOS],
+                 [types, bus.pop.type])
+  end
+
+  private
+  # Messages are dispatched in posting order: the tests post an
+  # expected message last so the excluded ones have been dispatched
+  # once it arrived.
+  def iterate_until
+    context = GLib::MainContext.default
+    100.times do
+      break if yield
+      context.iteration(false)
+    end
+  end
+end
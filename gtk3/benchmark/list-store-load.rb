@@ -0,0 +1,61 @@
+#!/usr/bin/env ruby
+#
+# Copyright (C) 2013  Ruby-GNOME2 Project Team
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+# Compares filling a Gtk::ListStore row by row with
+# Gtk::ListStore#append and Gtk::ListStore#set_values against
+# Gtk::ListStore#bulk_append and Gtk::ListStore#load_columns.
+#
+#   % ruby -I glib2/lib -I glib2/ext/glib2 \
+#       -I gobject-introspection/lib \
+#       -I gobject-introspection/ext/gobject-introspection \
+#       -I atk/lib -I atk/ext/atk -I pango/lib -I pango/ext/pango \
+#       -I cairo-gobject/lib -I cairo-gobject/ext/cairo-gobject \
+#       -I gdk_pixbuf2/lib -I gdk_pixbuf2/ext/gdk_pixbuf2 \
+#       -I gdk3/lib -I gdk3/ext/gdk3 \
+#       -I gtk3/lib -I gtk3/ext/gtk3 \
+#       gtk3/benchmark/list-store-load.rb [N_ROWS]
+
+require "benchmark"
+require "gtk3"
+
+n_rows = Integer(ARGV[0] || 100_000)
+
+ids = (0...n_rows).to_a
+names = ids.collect {|id| "row #{id}"}
+rows = ids.zip(names)
+
+def create_store
+  Gtk::ListStore.new(Integer, String)
+end
+
+Benchmark.bmbm do |benchmark|
+  benchmark.report("append+set_values") do
+    store = create_store
+    rows.each do |row|
+      store.set_values(store.append, row)
+    end
+  end
+  benchmark.report("bulk_append") do
+    store = create_store
+    store.bulk_append(rows)
+  end
+  benchmark.report("load_columns") do
+    store = create_store
+    store.load_columns(0 => ids, 1 => names)
+  end
+end
@@ -73,9 +73,8 @@ rg_set_value(VALUE self, VALUE iter, VALUE column, VALUE value)
 
     rbgobj_rvalue_to_gvalue(value, &gval);
 
-    G_CHILD_ADD(iter, value);
-
     gtk_list_store_set_value(_SELF(self), RVAL2GTKTREEITER(iter), NUM2INT(column), &gval);
+    rbgtk_tree_iter_retain_value(self, RVAL2GTKTREEITER(iter), NUM2INT(column), value);
 
     g_value_unset(&gval);
     return self;
@@ -84,6 +83,7 @@ rg_set_value(VALUE self, VALUE iter, VALUE column, VALUE value)
 typedef struct _ValuesInfo
 {
     gint i;
+    VALUE self;
     VALUE iter;
     GtkTreeModel *model;
     gint *g_columns;
@@ -101,19 +101,21 @@ collect_value(VALUE key, VALUE value, ValuesInfo *info)
     g_type = gtk_tree_model_get_column_type(info->model, column);
     g_value_init(&(info->g_values[info->i]), g_type);
     rbgobj_rvalue_to_gvalue(value, &(info->g_values[info->i]));
-    G_CHILD_ADD(info->iter, value);
+    rbgtk_tree_iter_retain_value(info->self, RVAL2GTKTREEITER(info->iter),
+                                 column, value);
     info->i++;
 
     return ST_CONTINUE;
 }
 
 static void
-hash_to_values(VALUE hash, VALUE iter, GtkTreeModel *model,
+hash_to_values(VALUE self, VALUE hash, VALUE iter, GtkTreeModel *model,
                gint *g_columns, GValue *g_values, G_GNUC_UNUSED gint length)
 {
     ValuesInfo info;
 
     info.i = 0;
+    info.self = self;
     info.iter = iter;
     info.model = model;
     info.g_columns = g_columns;
@@ -122,7 +124,7 @@ hash_to_values(VALUE hash, VALUE iter, GtkTreeModel *model,
 }
 
 static void
-array_to_values(VALUE array, VALUE iter, GtkTreeModel *model,
+array_to_values(VALUE self, VALUE array, VALUE iter, GtkTreeModel *model,
                 gint *g_columns, GValue *g_values, gint length)
 {
     gint i;
@@ -134,7 +136,8 @@ array_to_values(VALUE array, VALUE iter, GtkTreeModel *model,
         g_type = gtk_tree_model_get_column_type(model, i);
         g_value_init(&g_values[i], g_type);
         rbgobj_rvalue_to_gvalue(RARRAY_PTR(array)[i], &g_values[i]);
-        G_CHILD_ADD(iter, RARRAY_PTR(array)[i]);
+        rbgtk_tree_iter_retain_value(self, RVAL2GTKTREEITER(iter),
+                                     i, RARRAY_PTR(array)[i]);
     }
 }
 
@@ -158,10 +161,10 @@ rg_set_values(VALUE self, VALUE iter, VALUE values)
     store = _SELF(self);
     model = GTK_TREE_MODEL(store);
     if (RVAL2CBOOL(rb_obj_is_kind_of(values, rb_cHash))) {
-        hash_to_values(values, iter, model, g_columns, g_values, length);
+        hash_to_values(self, values, iter, model, g_columns, g_values, length);
     }
     else if (RVAL2CBOOL(rb_obj_is_kind_of(values, rb_cArray))) {
-        array_to_values(values, iter, model, g_columns, g_values, length);
+        array_to_values(self, values, iter, model, g_columns, g_values, length);
     }
     else {
         rb_raise(rb_eArgError, "must be array or hash of values");
@@ -180,10 +183,12 @@ static VALUE
 rg_remove(VALUE self, VALUE iter)
 {
     G_CHILD_REMOVE(self, iter);
+    rbgtk_tree_iter_release_values(self, RVAL2GTKTREEITER(iter));
     return CBOOL2RVAL(gtk_list_store_remove(_SELF(self), RVAL2GTKTREEITER(iter)));
 }
 
 struct lstore_insert_args {
+    VALUE self;
     GtkListStore *store;
     GtkTreeIter iter;
     gint position;
@@ -199,6 +204,7 @@ lstore_insert_body(VALUE value)
 {
     struct lstore_insert_args *args = (struct lstore_insert_args *)value;
     GtkTreeModel *model = GTK_TREE_MODEL(args->store);
+    long i;
 
     for (args->i = 0; args->i < args->n; args->i++) {
         VALUE ary = rb_ary_to_ary(RARRAY_PTR(args->ary)[args->i]);
@@ -215,6 +221,13 @@ lstore_insert_body(VALUE value)
                                        args->columns,
                                        args->values,
                                        args->n);
+    rbgtk_tree_iter_reset_values(args->self, &args->iter);
+
+    for (i = 0; i < args->n; i++) {
+        VALUE ary = rb_ary_to_ary(RARRAY_PTR(args->ary)[i]);
+        rbgtk_tree_iter_retain_value(args->self, &args->iter,
+                                     args->columns[i], RARRAY_PTR(ary)[0]);
+    }
 
     return Qnil;
 }
@@ -242,6 +255,7 @@ rg_insert(int argc, VALUE *argv, VALUE self)
 {
     VALUE position, values, result;
     struct lstore_insert_args args;
+    args.self = self;
     args.store = _SELF(self);
 
     rb_scan_args(argc, argv, "11", &position, &values);
@@ -249,6 +263,7 @@ rg_insert(int argc, VALUE *argv, VALUE self)
 
     if (NIL_P(values)){
         gtk_list_store_insert(args.store, &args.iter, args.position);
+        rbgtk_tree_iter_reset_values(self, &args.iter);
     } else {
         args.ary = rb_funcall(values, id_to_a, 0);
         args.n = RARRAY_LEN(args.ary);
@@ -266,6 +281,228 @@ rg_insert(int argc, VALUE *argv, VALUE self)
     return result;
 }
 
+struct lstore_bulk_args {
+    VALUE self;
+    GtkListStore *store;
+    gint n_columns;
+    GType *types;
+    gboolean *retain;
+    gint *columns;
+    GValue *values;
+    gint n_values;
+    VALUE rows;
+    VALUE column_values;
+    long n_rows;
+};
+
+static gboolean
+lstore_bulk_need_retain(GType gtype)
+{
+    switch (G_TYPE_FUNDAMENTAL(gtype)) {
+      case G_TYPE_CHAR:
+      case G_TYPE_UCHAR:
+      case G_TYPE_BOOLEAN:
+      case G_TYPE_INT:
+      case G_TYPE_UINT:
+      case G_TYPE_LONG:
+      case G_TYPE_ULONG:
+      case G_TYPE_INT64:
+      case G_TYPE_UINT64:
+      case G_TYPE_ENUM:
+      case G_TYPE_FLAGS:
+      case G_TYPE_FLOAT:
+      case G_TYPE_DOUBLE:
+      case G_TYPE_STRING:
+        return FALSE;
+      default:
+        return TRUE;
+    }
+}
+
+static void
+lstore_bulk_args_init(struct lstore_bulk_args *args, VALUE self)
+{
+    GtkTreeModel *model;
+    gint i;
+
+    args->self = self;
+    args->store = _SELF(self);
+    model = GTK_TREE_MODEL(args->store);
+    args->n_columns = gtk_tree_model_get_n_columns(model);
+    args->types = g_new(GType, args->n_columns);
+    args->retain = g_new(gboolean, args->n_columns);
+    args->columns = g_new(gint, args->n_columns);
+    args->values = g_new0(GValue, args->n_columns);
+    args->n_values = 0;
+    for (i = 0; i < args->n_columns; i++) {
+        args->types[i] = gtk_tree_model_get_column_type(model, i);
+        args->retain[i] = lstore_bulk_need_retain(args->types[i]);
+    }
+}
+
+static void
+lstore_bulk_set_value(struct lstore_bulk_args *args, gint column, VALUE value)
+{
+    GValue *gvalue = &args->values[args->n_values];
+
+    if (column < 0 || column >= args->n_columns)
+        rb_raise(rb_eArgError,
+                 "column index out of range: %d (0..%d)",
+                 column, args->n_columns - 1);
+
+    args->columns[args->n_values] = column;
+    g_value_init(gvalue, args->types[column]);
+    args->n_values++;
+    rbgobj_rvalue_to_gvalue(value, gvalue);
+}
+
+static void
+lstore_bulk_flush(struct lstore_bulk_args *args, VALUE *rb_values)
+{
+    GtkTreeIter iter;
+    gint i;
+
+    gtk_list_store_insert_with_valuesv(args->store, &iter, -1,
+                                       args->columns, args->values,
+                                       args->n_values);
+    rbgtk_tree_iter_reset_values(args->self, &iter);
+    for (i = 0; i < args->n_values; i++) {
+        gint column = args->columns[i];
+        if (args->retain[column])
+            rbgtk_tree_iter_retain_value(args->self, &iter, column, rb_values[i]);
+        g_value_unset(&args->values[i]);
+    }
+    args->n_values = 0;
+}
+
+static VALUE
+lstore_bulk_append_body(VALUE value)
+{
+    struct lstore_bulk_args *args = (struct lstore_bulk_args *)value;
+    long i;
+
+    for (i = 0; i < args->n_rows; i++) {
+        VALUE row = rb_ary_to_ary(RARRAY_PTR(args->rows)[i]);
+        long j, n = RARRAY_LEN(row);
+
+        if (n > args->n_columns)
+            rb_raise(rb_eArgError,
+                     "too many values in row %ld: %ld (max: %d)",
+                     i, n, args->n_columns);
+        for (j = 0; j < n; j++)
+            lstore_bulk_set_value(args, (gint)j, RARRAY_PTR(row)[j]);
+        lstore_bulk_flush(args, RARRAY_PTR(row));
+    }
+
+    return Qnil;
+}
+
+static VALUE
+lstore_load_columns_body(VALUE value)
+{
+    struct lstore_bulk_args *args = (struct lstore_bulk_args *)value;
+    VALUE columns = rb_funcall(args->column_values, id_to_a, 0);
+    long n_columns = RARRAY_LEN(columns);
+    gint *column_indexes;
+    VALUE *arrays, *rb_values;
+    long i, j;
+
+    if (n_columns > args->n_columns)
+        rb_raise(rb_eArgError,
+                 "too many columns: %ld (max: %d)",
+                 n_columns, args->n_columns);
+
+    column_indexes = ALLOCA_N(gint, n_columns);
+    arrays = ALLOCA_N(VALUE, n_columns);
+    rb_values = ALLOCA_N(VALUE, n_columns);
+    args->n_rows = -1;
+    for (i = 0; i < n_columns; i++) {
+        VALUE pair = rb_ary_to_ary(RARRAY_PTR(columns)[i]);
+
+        column_indexes[i] = NUM2INT(RARRAY_PTR(pair)[0]);
+        arrays[i] = rb_ary_to_ary(RARRAY_PTR(pair)[1]);
+        if (args->n_rows == -1) {
+            args->n_rows = RARRAY_LEN(arrays[i]);
+        } else if (RARRAY_LEN(arrays[i]) != args->n_rows) {
+            rb_raise(rb_eArgError,
+                     "all columns must have the same number of values: "
+                     "column %d has %ld values (expected: %ld)",
+                     column_indexes[i], RARRAY_LEN(arrays[i]), args->n_rows);
+        }
+    }
+
+    for (j = 0; j < args->n_rows; j++) {
+        for (i = 0; i < n_columns; i++) {
+            rb_values[i] = RARRAY_PTR(arrays[i])[j];
+            lstore_bulk_set_value(args, column_indexes[i], rb_values[i]);
+        }
+        lstore_bulk_flush(args, rb_values);
+    }
+
+    return Qnil;
+}
+
+static VALUE
+lstore_bulk_ensure(VALUE value)
+{
+    struct lstore_bulk_args *args = (struct lstore_bulk_args *)value;
+    gint i;
+
+    for (i = 0; i < args->n_values; i++)
+        g_value_unset(&args->values[i]);
+
+    g_free(args->values);
+    g_free(args->columns);
+    g_free(args->retain);
+    g_free(args->types);
+
+    return Qnil;
+}
+
+/*
+  Gtk::ListStore#bulk_append([[val0, val1, ...], [val0, val1, ...], ...])
+
+  Appends a row for each element of rows. Column types are resolved
+  once for the whole call. Detach the store from its views while
+  loading large data sets; GTK emits row-inserted for each row.
+ */
+static VALUE
+rg_bulk_append(VALUE self, VALUE rows)
+{
+    struct lstore_bulk_args args;
+
+    rows = rb_ary_to_ary(rows);
+    lstore_bulk_args_init(&args, self);
+    args.rows = rows;
+    args.n_rows = RARRAY_LEN(rows);
+
+    rb_ensure(lstore_bulk_append_body, (VALUE)&args,
+              lstore_bulk_ensure, (VALUE)&args);
+
+    return self;
+}
+
+/*
+  Gtk::ListStore#load_columns(column0 => [val, val, ...],
+                              column2 => [val, val, ...], ...)
+
+  Appends rows from per-column arrays. All arrays must have the same
+  length.
+ */
+static VALUE
+rg_load_columns(VALUE self, VALUE column_values)
+{
+    struct lstore_bulk_args args;
+
+    lstore_bulk_args_init(&args, self);
+    args.column_values = column_values;
+
+    rb_ensure(lstore_load_columns_body, (VALUE)&args,
+              lstore_bulk_ensure, (VALUE)&args);
+
+    return self;
+}
+
 static VALUE
 rg_insert_before(VALUE self, VALUE sibling)
 {
@@ -273,6 +510,7 @@ rg_insert_before(VALUE self, VALUE sibling)
     GtkTreeIter iter;
     GtkListStore* model = _SELF(self);
     gtk_list_store_insert_before(model, &iter, NIL_P(sibling) ? NULL : RVAL2GTKTREEITER(sibling));
+    rbgtk_tree_iter_reset_values(self, &iter);
     iter.user_data3 = model;
 
     ret = GTKTREEITER2RVAL(&iter);
@@ -286,6 +524,7 @@ rg_insert_after(VALUE self, VALUE sibling)
     GtkTreeIter iter;
     GtkListStore* model = _SELF(self);
     gtk_list_store_insert_after(model, &iter, NIL_P(sibling) ? NULL : RVAL2GTKTREEITER(sibling));
+    rbgtk_tree_iter_reset_values(self, &iter);
     iter.user_data3 = model;
 
     ret = GTKTREEITER2RVAL(&iter);
@@ -299,6 +538,7 @@ rg_prepend(VALUE self)
     GtkTreeIter iter;
     GtkListStore* model = _SELF(self);
     gtk_list_store_prepend(model, &iter);
+    rbgtk_tree_iter_reset_values(self, &iter);
     iter.user_data3 = model;
 
     ret = GTKTREEITER2RVAL(&iter);
@@ -312,6 +552,7 @@ rg_append(VALUE self)
     GtkTreeIter iter;
     GtkListStore* model = _SELF(self);
     gtk_list_store_append(model, &iter);
+    rbgtk_tree_iter_reset_values(self, &iter);
     iter.user_data3 = model;
 
     ret = GTKTREEITER2RVAL(&iter);
@@ -322,6 +563,7 @@ static VALUE
 rg_clear(VALUE self)
 {
     G_CHILD_REMOVE_ALL(self);
+    rbgtk_tree_iter_release_all_values(self);
     gtk_list_store_clear(_SELF(self));
     return self;
 }
@@ -396,4 +638,6 @@ Init_gtk_list_store(VALUE mGtk)
     RG_DEF_METHOD(move_before, 2);
     RG_DEF_METHOD(move_after, 2);
     RG_DEF_METHOD(set_values, 2);
+    RG_DEF_METHOD(bulk_append, 1);
+    RG_DEF_METHOD(load_columns, 1);
 }
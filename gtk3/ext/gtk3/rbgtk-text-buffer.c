@@ -696,59 +696,380 @@ rg_create_tag(VALUE self, VALUE tag_name, VALUE properties)
     return ret;
 }
 
+static GtkTextTag *
+rval2tag(VALUE self, VALUE tag)
+{
+    if (rb_obj_is_kind_of(tag, GTYPE2CLASS(GTK_TYPE_TEXT_TAG)))
+        return RVAL2GTKTEXTTAG(tag);
+
+    return gtk_text_tag_table_lookup(gtk_text_buffer_get_tag_table(_SELF(self)),
+                                     RVAL2CSTR(tag));
+}
+
 static VALUE
 rg_insert(int argc, VALUE *argv, VALUE self)
 {
     VALUE where, value, tags;
+    volatile VALUE rb_iter;
     gint start_offset;
     GtkTextIter start;
+    GtkTextIter *iter;
     int i;
 
     rb_scan_args(argc, argv, "2*", &where, &value, &tags);
 
-    G_CHILD_ADD(self, where);
-    G_CHILD_ADD(self, value);
+    rb_iter = rg_get_iter_at(self, where);
+    iter = RVAL2GTKTEXTITER(rb_iter);
+    /* GtkTextBuffer refers pixbufs and child anchors but copies text,
+     * so only the former need to be kept alive with the buffer. */
     if (rb_obj_is_kind_of(value, GTYPE2CLASS(GDK_TYPE_PIXBUF))){
-        gtk_text_buffer_insert_pixbuf(_SELF(self), RVAL2ITER(self, where),
-                                      RVAL2GDKPIXBUF(value));
+        G_CHILD_ADD(self, value);
+        gtk_text_buffer_insert_pixbuf(_SELF(self), iter, RVAL2GDKPIXBUF(value));
     } else if (rb_obj_is_kind_of(value, GTYPE2CLASS(GTK_TYPE_TEXT_CHILD_ANCHOR))){
-        gtk_text_buffer_insert_child_anchor(_SELF(self), RVAL2ITER(self, where),
+        G_CHILD_ADD(self, value);
+        gtk_text_buffer_insert_child_anchor(_SELF(self), iter,
                                             RVAL2GTKTEXTCHILDANCHOR(value));
     } else {
-        start_offset = gtk_text_iter_get_offset(RVAL2ITER(self, where));
+        start_offset = gtk_text_iter_get_offset(iter);
         StringValue(value);
-        gtk_text_buffer_insert(_SELF(self), RVAL2ITER(self, where),
+        gtk_text_buffer_insert(_SELF(self), iter,
                                RSTRING_PTR(value), RSTRING_LEN(value));
 
         if (RARRAY_LEN(tags) == 0)
             return self;
 
-        /* TODO: Do we really want to do this before we know that everything
-         * below passed without any errors? */
-        G_CHILD_ADD(self, tags);
-
         gtk_text_buffer_get_iter_at_offset(_SELF(self), &start, start_offset);
 
         for(i = 0; i < RARRAY_LEN(tags); i++) {
             GtkTextTag *tag;
 
-            if (rb_obj_is_kind_of(RARRAY_PTR(tags)[i], GTYPE2CLASS(GTK_TYPE_TEXT_TAG))) {
-                tag = RVAL2GOBJ(RARRAY_PTR(tags)[i]);
-            } else {
-                tag = gtk_text_tag_table_lookup(gtk_text_buffer_get_tag_table(_SELF(self)),
-                                                RVAL2CSTR(RARRAY_PTR(tags)[i]));
-                if (tag == NULL) {
-                    g_warning ("%s: no tag with name '%s'!",
-                               G_STRLOC, RVAL2CSTR(RARRAY_PTR(tags)[i]));
-                    return self;
-                }
+            tag = rval2tag(self, RARRAY_PTR(tags)[i]);
+            if (tag == NULL) {
+                g_warning ("%s: no tag with name '%s'!",
+                           G_STRLOC, RVAL2CSTR(RARRAY_PTR(tags)[i]));
+                return self;
             }
-            gtk_text_buffer_apply_tag(_SELF(self), tag, &start, RVAL2ITER(self, where));
+            gtk_text_buffer_apply_tag(_SELF(self), tag, &start, iter);
         }
     }
     return self;
 }
 
+static VALUE
+lines_to_text(VALUE lines)
+{
+    VALUE text;
+    long i;
+
+    lines = rb_convert_type(lines, T_ARRAY, "Array", "to_ary");
+    text = rb_str_buf_new(0);
+    for (i = 0; i < RARRAY_LEN(lines); i++) {
+        VALUE line = RARRAY_PTR(lines)[i];
+
+        StringValue(line);
+        rb_str_buf_cat(text, RSTRING_PTR(line), RSTRING_LEN(line));
+        if (RSTRING_LEN(line) == 0 ||
+            RSTRING_PTR(line)[RSTRING_LEN(line) - 1] != '\n')
+            rb_str_buf_cat(text, "\n", 1);
+    }
+    return text;
+}
+
+static void
+resolve_tags(VALUE self, VALUE tags, GtkTextTag **resolved_tags)
+{
+    long i;
+
+    for (i = 0; i < RARRAY_LEN(tags); i++) {
+        resolved_tags[i] = rval2tag(self, RARRAY_PTR(tags)[i]);
+        if (!resolved_tags[i])
+            rb_raise(rb_eArgError, "no tag with name '%s'",
+                     RVAL2CSTR(RARRAY_PTR(tags)[i]));
+    }
+}
+
+static void
+text_buffer_append(GtkTextBuffer *buffer, const gchar *text, gsize length,
+                   GtkTextTag **tags, guint n_tags)
+{
+    GtkTextIter start, end;
+    gint start_offset;
+    guint i;
+
+    gtk_text_buffer_get_end_iter(buffer, &end);
+    start_offset = gtk_text_iter_get_offset(&end);
+    gtk_text_buffer_insert(buffer, &end, text, length);
+    gtk_text_buffer_get_iter_at_offset(buffer, &start, start_offset);
+    for (i = 0; i < n_tags; i++)
+        gtk_text_buffer_apply_tag(buffer, tags[i], &start, &end);
+}
+
+/* Deletes the first lines so that at most max_lines lines remain. An
+ * empty last line after a trailing newline isn't counted. */
+static void
+text_buffer_trim(GtkTextBuffer *buffer, gint max_lines)
+{
+    GtkTextIter start, end;
+    gint n_lines;
+
+    if (max_lines <= 0)
+        return;
+
+    gtk_text_buffer_get_end_iter(buffer, &end);
+    n_lines = gtk_text_iter_get_line(&end);
+    if (gtk_text_iter_get_line_offset(&end) > 0)
+        n_lines++;
+    if (n_lines <= max_lines)
+        return;
+
+    gtk_text_buffer_get_start_iter(buffer, &start);
+    gtk_text_buffer_get_iter_at_line(buffer, &end, n_lines - max_lines);
+    gtk_text_buffer_delete(buffer, &start, &end);
+}
+
+/*
+ * Lines queued by #queue_lines are coalesced for one frame interval
+ * and appended in one user action, which also trims the buffer to
+ * #max_lines. An idle wouldn't do: it runs after every main loop
+ * dispatch, which is once per chunk of a busy IO channel rather than
+ * once per frame. Consecutive lines with the same tags share one
+ * batch, so tags are applied once per batch.
+ */
+#define LINE_QUEUE_FLUSH_INTERVAL 16 /* ms, about one frame at 60Hz */
+
+typedef struct {
+    GString *text;
+    GPtrArray *tags;
+} LineBatch;
+
+typedef struct {
+    GtkTextBuffer *buffer;
+    gint max_lines;
+    GPtrArray *batches;
+    guint flush_id;
+} LineQueue;
+
+static GQuark q_line_queue;
+
+static void
+line_batch_free(gpointer data)
+{
+    LineBatch *batch = data;
+
+    g_string_free(batch->text, TRUE);
+    g_ptr_array_free(batch->tags, TRUE);
+    g_free(batch);
+}
+
+static void
+line_queue_free(gpointer data)
+{
+    LineQueue *queue = data;
+
+    if (queue->flush_id > 0)
+        g_source_remove(queue->flush_id);
+    g_ptr_array_free(queue->batches, TRUE);
+    g_free(queue);
+}
+
+static LineQueue *
+line_queue_get(GtkTextBuffer *buffer, gboolean create)
+{
+    LineQueue *queue;
+
+    queue = g_object_get_qdata(G_OBJECT(buffer), q_line_queue);
+    if (!queue && create) {
+        queue = g_new0(LineQueue, 1);
+        queue->buffer = buffer;
+        queue->batches = g_ptr_array_new_with_free_func(line_batch_free);
+        g_object_set_qdata_full(G_OBJECT(buffer), q_line_queue,
+                                queue, line_queue_free);
+    }
+    return queue;
+}
+
+/* Appends the queued batches. The caller wraps it in a user action.
+ * Lines queued by signal handlers meanwhile go to the next flush. */
+static void
+line_queue_append(LineQueue *queue)
+{
+    GPtrArray *batches;
+    guint i;
+
+    if (queue->flush_id > 0) {
+        g_source_remove(queue->flush_id);
+        queue->flush_id = 0;
+    }
+    batches = queue->batches;
+    queue->batches = g_ptr_array_new_with_free_func(line_batch_free);
+    for (i = 0; i < batches->len; i++) {
+        LineBatch *batch = g_ptr_array_index(batches, i);
+
+        text_buffer_append(queue->buffer,
+                           batch->text->str, batch->text->len,
+                           (GtkTextTag **)batch->tags->pdata,
+                           batch->tags->len);
+    }
+    g_ptr_array_free(batches, TRUE);
+}
+
+static void
+line_queue_flush(LineQueue *queue)
+{
+    gtk_text_buffer_begin_user_action(queue->buffer);
+    line_queue_append(queue);
+    text_buffer_trim(queue->buffer, queue->max_lines);
+    gtk_text_buffer_end_user_action(queue->buffer);
+}
+
+static gboolean
+line_queue_flush_timeout(gpointer data)
+{
+    LineQueue *queue = data;
+
+    queue->flush_id = 0;
+    line_queue_flush(queue);
+    return FALSE;
+}
+
+/*
+ * Gtk::TextBuffer#append_lines(lines, *tags)
+ *
+ * Appends each String of lines as a line at the end of the buffer in
+ * one user action and applies tags once to the whole batch. Lines
+ * queued by #queue_lines are appended before them.
+ */
+static VALUE
+rg_append_lines(int argc, VALUE *argv, VALUE self)
+{
+    VALUE lines, tags, text;
+    GtkTextBuffer *buffer;
+    GtkTextTag **resolved_tags;
+    LineQueue *queue;
+
+    rb_scan_args(argc, argv, "1*", &lines, &tags);
+    if (RARRAY_LEN(tags) == 1 && TYPE(RARRAY_PTR(tags)[0]) == T_ARRAY)
+        tags = RARRAY_PTR(tags)[0];
+
+    buffer = _SELF(self);
+    text = lines_to_text(lines);
+    resolved_tags = ALLOCA_N(GtkTextTag *, RARRAY_LEN(tags));
+    resolve_tags(self, tags, resolved_tags);
+
+    queue = line_queue_get(buffer, FALSE);
+    gtk_text_buffer_begin_user_action(buffer);
+    if (queue)
+        line_queue_append(queue);
+    text_buffer_append(buffer, RSTRING_PTR(text), RSTRING_LEN(text),
+                       resolved_tags, RARRAY_LEN(tags));
+    RB_GC_GUARD(text);
+    if (queue)
+        text_buffer_trim(buffer, queue->max_lines);
+    gtk_text_buffer_end_user_action(buffer);
+
+    return self;
+}
+
+/*
+ * Gtk::TextBuffer#queue_lines(lines, *tags)
+ *
+ * Like #append_lines but the lines are appended from the main loop
+ * together with all other lines queued within the same frame
+ * interval (16ms).
+ */
+static VALUE
+rg_queue_lines(int argc, VALUE *argv, VALUE self)
+{
+    VALUE lines, tags, text;
+    GtkTextTag **resolved_tags;
+    LineQueue *queue;
+    LineBatch *batch = NULL;
+    long i, n_tags;
+
+    rb_scan_args(argc, argv, "1*", &lines, &tags);
+    if (RARRAY_LEN(tags) == 1 && TYPE(RARRAY_PTR(tags)[0]) == T_ARRAY)
+        tags = RARRAY_PTR(tags)[0];
+
+    text = lines_to_text(lines);
+    n_tags = RARRAY_LEN(tags);
+    resolved_tags = ALLOCA_N(GtkTextTag *, n_tags);
+    resolve_tags(self, tags, resolved_tags);
+
+    queue = line_queue_get(_SELF(self), TRUE);
+    if (queue->batches->len > 0) {
+        batch = g_ptr_array_index(queue->batches, queue->batches->len - 1);
+        if (batch->tags->len != (guint)n_tags ||
+            memcmp(batch->tags->pdata, resolved_tags,
+                   sizeof(GtkTextTag *) * n_tags) != 0)
+            batch = NULL;
+    }
+    if (!batch) {
+        batch = g_new(LineBatch, 1);
+        batch->text = g_string_new(NULL);
+        batch->tags = g_ptr_array_new_with_free_func(g_object_unref);
+        for (i = 0; i < n_tags; i++)
+            g_ptr_array_add(batch->tags, g_object_ref(resolved_tags[i]));
+        g_ptr_array_add(queue->batches, batch);
+    }
+    g_string_append_len(batch->text, RSTRING_PTR(text), RSTRING_LEN(text));
+
+    if (queue->flush_id == 0)
+        queue->flush_id = g_timeout_add_full(GDK_PRIORITY_REDRAW - 1,
+                                             LINE_QUEUE_FLUSH_INTERVAL,
+                                             line_queue_flush_timeout,
+                                             queue,
+                                             NULL);
+
+    return self;
+}
+
+/* Appends the lines queued by #queue_lines now. */
+static VALUE
+rg_flush_lines(VALUE self)
+{
+    LineQueue *queue;
+
+    queue = line_queue_get(_SELF(self), FALSE);
+    if (queue)
+        line_queue_flush(queue);
+    return self;
+}
+
+static VALUE
+rg_max_lines(VALUE self)
+{
+    LineQueue *queue;
+
+    queue = line_queue_get(_SELF(self), FALSE);
+    if (!queue || queue->max_lines <= 0)
+        return Qnil;
+    return INT2NUM(queue->max_lines);
+}
+
+/*
+ * Bounds the buffer to the last max_lines lines, or makes it unbounded
+ * with nil. The head is trimmed in the same user action as each
+ * #append_lines and each flush of #queue_lines.
+ */
+static VALUE
+rg_set_max_lines(VALUE self, VALUE max_lines)
+{
+    GtkTextBuffer *buffer = _SELF(self);
+    LineQueue *queue;
+    gint n;
+
+    n = NIL_P(max_lines) ? 0 : NUM2INT(max_lines);
+    if (n < 0)
+        rb_raise(rb_eArgError, "max_lines must not be negative: %d", n);
+
+    queue = line_queue_get(buffer, TRUE);
+    queue->max_lines = n;
+    gtk_text_buffer_begin_user_action(buffer);
+    text_buffer_trim(buffer, n);
+    gtk_text_buffer_end_user_action(buffer);
+    return self;
+}
+
 static VALUE
 rg_apply_tag(int argc, VALUE *argv, VALUE self)
 {
@@ -824,12 +1145,19 @@ Init_gtk_textbuffer(VALUE mGtk)
     rb_mGtk = mGtk;
     VALUE RG_TARGET_NAMESPACE = G_DEF_CLASS(GTK_TYPE_TEXT_BUFFER, "TextBuffer", mGtk);
 
+    q_line_queue = g_quark_from_static_string("__ruby_gtk_text_buffer_line_queue");
+
     RG_DEF_METHOD(initialize, -1);
     RG_DEF_METHOD(line_count, 0);
     RG_DEF_METHOD(char_count, 0);
 
     G_REPLACE_SET_PROPERTY(RG_TARGET_NAMESPACE, "text", txt_set_text, 1);
     RG_DEF_METHOD(insert, -1);
+    RG_DEF_METHOD(append_lines, -1);
+    RG_DEF_METHOD(queue_lines, -1);
+    RG_DEF_METHOD(flush_lines, 0);
+    RG_DEF_METHOD(max_lines, 0);
+    RG_DEF_METHOD(set_max_lines, 1);
     RG_DEF_METHOD(backspace, 3);
     RG_DEF_METHOD(insert_at_cursor, 1);
     RG_DEF_METHOD(insert_interactive, 3);
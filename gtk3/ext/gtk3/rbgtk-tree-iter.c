@@ -39,6 +39,84 @@ rbgtk_register_treeiter_set_value_func(GType gtype, rbgtkiter_set_value_func fun
                  Data_Wrap_Struct(rb_cData, NULL, NULL, func));
 }
 
+static ID id_row_values;
+
+/*
+ * Ruby values written into model cells are kept alive in a per-row
+ * slot table on the model: {row => {column => value}}. Rows are keyed by
+ * the iter's user_data, which list and tree stores keep stable for the
+ * lifetime of a row, so overwriting a cell replaces the old reference
+ * instead of accumulating it.
+ */
+static VALUE
+row_key(GtkTreeIter *iter)
+{
+    return ULONG2NUM((unsigned long)iter->user_data);
+}
+
+void
+rbgtk_tree_iter_retain_value(VALUE model, GtkTreeIter *iter,
+                             gint column, VALUE value)
+{
+    VALUE rows, row;
+
+    rows = rb_attr_get(model, id_row_values);
+    if (NIL_P(rows)) {
+        rows = rb_hash_new();
+        rb_ivar_set(model, id_row_values, rows);
+    }
+
+    row = rb_hash_aref(rows, row_key(iter));
+    if (NIL_P(row)) {
+        row = rb_hash_new();
+        rb_hash_aset(rows, row_key(iter), row);
+    }
+    rb_hash_aset(row, INT2NUM(column), value);
+}
+
+/*
+ * Drops the slot of a row that was just created. Rows removed by C code
+ * (drag and drop, other bindings) never release their slot, and a new
+ * row may reuse their user_data, so it must not inherit those values.
+ */
+void
+rbgtk_tree_iter_reset_values(VALUE model, GtkTreeIter *iter)
+{
+    VALUE rows;
+
+    rows = rb_attr_get(model, id_row_values);
+    if (NIL_P(rows))
+        return;
+    rb_hash_delete(rows, row_key(iter));
+}
+
+void
+rbgtk_tree_iter_release_values(VALUE model, GtkTreeIter *iter)
+{
+    VALUE rows;
+    GtkTreeModel *tree_model;
+    GtkTreeIter child;
+
+    rows = rb_attr_get(model, id_row_values);
+    if (NIL_P(rows))
+        return;
+
+    tree_model = RVAL2GTKTREEMODEL(model);
+    if (gtk_tree_model_iter_children(tree_model, &child, iter)) {
+        do {
+            rbgtk_tree_iter_release_values(model, &child);
+        } while (gtk_tree_model_iter_next(tree_model, &child));
+    }
+
+    rb_hash_delete(rows, row_key(iter));
+}
+
+void
+rbgtk_tree_iter_release_all_values(VALUE model)
+{
+    rb_ivar_set(model, id_row_values, Qnil);
+}
+
 static VALUE
 rg_first_bang(VALUE self)
 {
@@ -161,6 +239,8 @@ rg_set_value(VALUE self, VALUE column, VALUE value)
     func(model, iter, NUM2INT(column), &gval);
     g_value_unset(&gval);
 
+    rbgtk_tree_iter_retain_value(GOBJ2RVAL(model), iter, NUM2INT(column), value);
+
     return self;
 }
 
@@ -240,6 +320,8 @@ Init_gtk_treeiter(VALUE mGtk)
 {
     VALUE RG_TARGET_NAMESPACE = G_DEF_CLASS(GTK_TYPE_TREE_ITER, "TreeIter", mGtk);
 
+    id_row_values = rb_intern("__row_values__");
+
     RG_DEF_METHOD_BANG(first, 0);
     RG_DEF_METHOD_BANG(next, 0);
     RG_DEF_METHOD(get_value, 1);
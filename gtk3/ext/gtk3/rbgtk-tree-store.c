@@ -71,10 +71,8 @@ rg_set_value(VALUE self, VALUE iter, VALUE column, VALUE value)
 
     rbgobj_rvalue_to_gvalue(value, &gval);
 
-    G_CHILD_ADD(self, iter);
-    G_CHILD_ADD(iter, value);
-
     gtk_tree_store_set_value(_SELF(self), RVAL2GTKTREEITER(iter), NUM2INT(column), &gval);
+    rbgtk_tree_iter_retain_value(self, RVAL2GTKTREEITER(iter), NUM2INT(column), value);
 
     g_value_unset(&gval);
     return self;
@@ -84,6 +82,7 @@ static VALUE
 rg_remove(VALUE self, VALUE iter)
 {
     G_CHILD_REMOVE(self, iter);
+    rbgtk_tree_iter_release_values(self, RVAL2GTKTREEITER(iter));
     return CBOOL2RVAL(gtk_tree_store_remove(_SELF(self), RVAL2GTKTREEITER(iter)));
 }
 
@@ -101,6 +100,7 @@ rg_insert(int argc, VALUE *argv, VALUE self)
                               NIL_P(parent) ? NULL : RVAL2GTKTREEITER(parent), 
                               NUM2INT(position));
         iter.user_data3 = model;
+        rbgtk_tree_iter_reset_values(self, &iter);
         ret = GTKTREEITER2RVAL(&iter);
         G_CHILD_ADD(self, ret);
     } else {
@@ -152,12 +152,14 @@ rg_insert(int argc, VALUE *argv, VALUE self)
                                            c_values,
                                            size);
         iter.user_data3 = model;
+        rbgtk_tree_iter_reset_values(self, &iter);
 
         ret = GTKTREEITER2RVAL(&iter);
         G_CHILD_ADD(self, ret);
 
         for(i=0; i<size; i++) {
-            G_CHILD_ADD(ret, rbgobj_gvalue_to_rvalue(&(c_values[i])));
+            rbgtk_tree_iter_retain_value(self, &iter, c_columns[i],
+                                         rbgobj_gvalue_to_rvalue(&(c_values[i])));
             g_value_unset(&(c_values[i]));
         }
     }
@@ -175,6 +177,7 @@ rg_insert_before(VALUE self, VALUE parent, VALUE sibling)
                                  NIL_P(parent) ? NULL : RVAL2GTKTREEITER(parent), 
                                  NIL_P(sibling) ? NULL : RVAL2GTKTREEITER(sibling));
     iter.user_data3 = model;
+    rbgtk_tree_iter_reset_values(self, &iter);
     ret = GTKTREEITER2RVAL(&iter);
     G_CHILD_ADD(self, ret);
     return ret;
@@ -190,6 +193,7 @@ rg_insert_after(VALUE self, VALUE parent, VALUE sibling)
                                 NIL_P(parent) ? NULL : RVAL2GTKTREEITER(parent), 
                                 NIL_P(sibling) ? NULL : RVAL2GTKTREEITER(sibling));
     iter.user_data3 = model;
+    rbgtk_tree_iter_reset_values(self, &iter);
 
     ret = GTKTREEITER2RVAL(&iter);
     G_CHILD_ADD(self, ret);
@@ -205,6 +209,7 @@ rg_prepend(VALUE self, VALUE parent)
     gtk_tree_store_prepend(model, &iter, 
                            NIL_P(parent)?NULL:RVAL2GTKTREEITER(parent));
     iter.user_data3 = model;
+    rbgtk_tree_iter_reset_values(self, &iter);
 
     ret = GTKTREEITER2RVAL(&iter);
     G_CHILD_ADD(self, ret);
@@ -220,6 +225,7 @@ rg_append(VALUE self, VALUE parent)
     gtk_tree_store_append(model, &iter, 
                           NIL_P(parent)?NULL:RVAL2GTKTREEITER(parent));
     iter.user_data3 = model;
+    rbgtk_tree_iter_reset_values(self, &iter);
 
     ret = GTKTREEITER2RVAL(&iter);
     G_CHILD_ADD(self, ret);
@@ -243,6 +249,7 @@ static VALUE
 rg_clear(VALUE self)
 {
     G_CHILD_REMOVE_ALL(self);
+    rbgtk_tree_iter_release_all_values(self);
     gtk_tree_store_clear(_SELF(self));
     return self;
 }
@@ -56,6 +56,11 @@ G_GNUC_INTERNAL void exec_callback(GtkWidget *widget, gpointer proc);
 typedef void (*rbgtkiter_set_value_func)(void *model, GtkTreeIter *iter,
                                          gint column, GValue *value);
 G_GNUC_INTERNAL void rbgtk_register_treeiter_set_value_func(GType, rbgtkiter_set_value_func);
+G_GNUC_INTERNAL void rbgtk_tree_iter_retain_value(VALUE model, GtkTreeIter *iter,
+                                                  gint column, VALUE value);
+G_GNUC_INTERNAL void rbgtk_tree_iter_reset_values(VALUE model, GtkTreeIter *iter);
+G_GNUC_INTERNAL void rbgtk_tree_iter_release_values(VALUE model, GtkTreeIter *iter);
+G_GNUC_INTERNAL void rbgtk_tree_iter_release_all_values(VALUE model);
 
 G_GNUC_INTERNAL void rbgtk_atom2selectiondata(VALUE type, VALUE size, VALUE src, GdkAtom* gtype,
                                      void** data, gint* format, gint* length);
@@ -76,6 +76,24 @@ class TestGtkListStore < Test::Unit::TestCase
     assert_equal([2, 'she'], [iter[ID], iter[NAME]])
   end
 
+  def test_bulk_append
+    @store.bulk_append([[0, "me"], [1, "you"], [2]])
+    assert_equal([[0, "me"], [1, "you"], [2, nil]],
+                 @store.to_enum(:each).collect {|model, path, iter| [iter[ID], iter[NAME]]})
+  end
+
+  def test_load_columns
+    @store.load_columns(ID => [0, 1], NAME => ["me", "you"])
+    assert_equal([[0, "me"], [1, "you"]],
+                 @store.to_enum(:each).collect {|model, path, iter| [iter[ID], iter[NAME]]})
+  end
+
+  def test_load_columns_different_size
+    assert_raise(ArgumentError) do
+      @store.load_columns(ID => [0, 1], NAME => ["me"])
+    end
+  end
+
   def test_iter_gc
     n_iterators = count_objects(Gtk::TreeIter)
     50.times do |i|
@@ -94,6 +112,51 @@ class TestGtkListStore < Test::Unit::TestCase
     assert_equal(n_iterators, count_objects(Gtk::TreeIter))
   end
 
+  class Cell
+  end
+
+  def test_overwritten_value_gc
+    store = Gtk::ListStore.new(Object)
+    iters = 100.times.collect do
+      iter = store.append
+      store.set_value(iter, 0, Cell.new)
+      iter
+    end
+    GC.start
+    n_retained = count_cells
+    assert_operator(n_retained, :>=, iters.size)
+
+    iters.each do |iter|
+      10.times do
+        store.set_value(iter, 0, Cell.new)
+      end
+    end
+    GC.start
+    assert_operator(count_cells, :<, n_retained + iters.size)
+
+    iters.each do |iter|
+      store.remove(iter)
+    end
+    iters = nil
+    GC.start
+    assert_operator(count_cells, :<, n_retained / 2)
+  end
+
+  def test_row_values_soak
+    store = Gtk::ListStore.new(Object)
+    10000.times do
+      iter = store.append
+      3.times do
+        store.set_value(iter, 0, Cell.new)
+      end
+      store.remove(iter)
+    end
+    GC.start
+    # Each retained row slot keeps its Cell alive, so the number of
+    # live Cells is an upper bound of the slot table.
+    assert_operator(count_cells, :<, 100)
+  end
+
   private
   def count_objects(klass)
     n_objects = ObjectSpace.each_object(Gtk::TreeIter) do
@@ -101,4 +164,10 @@ class TestGtkListStore < Test::Unit::TestCase
     end
     n_objects
   end
+
+  def count_cells
+    ObjectSpace.each_object(Cell) do
+      # do nothing
+    end
+  end
 end
@@ -0,0 +1,76 @@
+class TestGtkTextBuffer < Test::Unit::TestCase
+  include GtkTestUtils
+
+  def setup
+    @buffer = Gtk::TextBuffer.new
+  end
+
+  def test_insert_with_tags
+    bold = @buffer.create_tag("bold", "foreground" => "blue")
+    @buffer.insert(@buffer.end_iter, "Hello")
+    @buffer.insert(@buffer.end_iter, " world", "bold")
+    start = @buffer.get_iter_at(:offset => 6)
+    assert_equal(["Hello world", true, false],
+                 [@buffer.text,
+                  start.has_tag?(bold),
+                  @buffer.get_iter_at(:offset => 4).has_tag?(bold)])
+  end
+
+  def test_append_lines
+    error = @buffer.create_tag("error", "foreground" => "red")
+    @buffer.text = "first\n"
+    @buffer.append_lines(["second", "third\n"], [error])
+    assert_equal(["first\nsecond\nthird\n", false, true],
+                 [@buffer.text,
+                  @buffer.get_iter_at(:line => 0).has_tag?(error),
+                  @buffer.get_iter_at(:line => 2).has_tag?(error)])
+  end
+
+  def test_queue_lines_flush_from_main_loop
+    @buffer.queue_lines(["1"])
+    @buffer.queue_lines(["2"])
+    context = GLib::MainContext.default
+    100.times do
+      break unless @buffer.text.empty?
+      sleep(0.01)
+      context.iteration(false)
+    end
+    assert_equal("1\n2\n", @buffer.text)
+  end
+
+  def test_append_lines_unknown_tag
+    assert_raise(ArgumentError) do
+      @buffer.append_lines(["line"], "nonexistent")
+    end
+    assert_equal("", @buffer.text)
+  end
+
+  def test_max_lines
+    @buffer.text = "1\n2\n3\n4\n"
+    assert_nil(@buffer.max_lines)
+    @buffer.max_lines = 2
+    assert_equal([2, "3\n4\n"], [@buffer.max_lines, @buffer.text])
+  end
+
+  def test_append_lines_with_max_lines
+    @buffer.max_lines = 3
+    @buffer.append_lines(["1", "2"])
+    @buffer.append_lines(["3", "4", "5"])
+    assert_equal("3\n4\n5\n", @buffer.text)
+  end
+
+  def test_queue_lines
+    error = @buffer.create_tag("error", "foreground" => "red")
+    @buffer.max_lines = 3
+    @buffer.queue_lines(["1", "2"])
+    @buffer.queue_lines(["3"], "error")
+    @buffer.queue_lines(["4"], "error")
+    assert_equal("", @buffer.text)
+    @buffer.flush_lines
+    assert_equal(["2\n3\n4\n", false, true, true],
+                 [@buffer.text,
+                  @buffer.get_iter_at(:line => 0).has_tag?(error),
+                  @buffer.get_iter_at(:line => 1).has_tag?(error),
+                  @buffer.get_iter_at(:line => 2).has_tag?(error)])
+  end
+end
@@ -0,0 +1,82 @@
+# Copyright (C) 2013  Ruby-GNOME2 Project Team
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+# MA  02110-1301  USA
+
+class TestGtkTreeStore < Test::Unit::TestCase
+  include GtkTestUtils
+
+  class Cell
+  end
+
+  def setup
+    @store = Gtk::TreeStore.new(Object)
+  end
+
+  def test_overwritten_value_gc
+    iter = @store.append(nil)
+    @store.set_value(iter, 0, Cell.new)
+    GC.start
+    n_retained = count_cells
+
+    100.times do
+      @store.set_value(iter, 0, Cell.new)
+    end
+    GC.start
+    assert_operator(count_cells, :<, n_retained + 50)
+  end
+
+  def test_removed_value_gc
+    parents = 10.times.collect do
+      parent = @store.append(nil)
+      @store.set_value(parent, 0, Cell.new)
+      10.times do
+        child = @store.append(parent)
+        @store.set_value(child, 0, Cell.new)
+      end
+      parent
+    end
+    GC.start
+    n_retained = count_cells
+    assert_operator(n_retained, :>=, 110)
+
+    parents.each do |parent|
+      @store.remove(parent)
+    end
+    parents = nil
+    GC.start
+    assert_operator(count_cells, :<, n_retained / 2)
+  end
+
+  def test_row_values_soak
+    parent = @store.append(nil)
+    10000.times do
+      iter = @store.append(parent)
+      3.times do
+        @store.set_value(iter, 0, Cell.new)
+      end
+      @store.remove(iter)
+    end
+    GC.start
+    assert_operator(count_cells, :<, 100)
+  end
+
+  private
+  def count_cells
+    ObjectSpace.each_object(Cell) do
+      # do nothing
+    end
+  end
+end